@@ -4,20 +4,44 @@ add_executable(maze_generator_app
     src/cli/framework/cli_app.cpp
     src/cli/commands/generation_algorithms_command.cpp
     src/cli/commands/search_algorithms_command.cpp
+    src/cli/commands/query_pairs_command.cpp
+    src/cli/commands/distance_field_command.cpp
     src/cli/commands/version_command.cpp
+    src/cli/commands/fuzz_command.cpp
     src/common/pch.cpp
     src/infrastructure/config/config_loader.cpp
     src/domain/maze_generation.cpp
     src/domain/maze_solver_common.cpp
+    src/domain/maze_compact_path.cpp
     src/domain/maze_solver.cpp
-    src/domain/maze_solver_bfs.cpp
-    src/domain/maze_solver_dfs.cpp
-    src/domain/maze_solver_astar.cpp
-    src/domain/maze_solver_dijkstra.cpp
-    src/domain/maze_solver_greedy.cpp
+    src/domain/maze_solver_search.cpp
+    src/domain/maze_solver_bitboard.cpp
+    src/domain/maze_solver_parallel_astar.cpp
+    src/domain/maze_adjacency.cpp
+    src/domain/maze_junction_graph.cpp
+    src/domain/maze_solver_junction_graph.cpp
+    src/domain/maze_path_index.cpp
+    src/domain/maze_solver_tree_lca.cpp
+    src/domain/maze_dead_end_filler.cpp
+    src/domain/maze_solver_dead_end_filling.cpp
+    src/domain/maze_batch_solver.cpp
+    src/domain/maze_solve_cache.cpp
+    src/domain/maze_distance_field.cpp
+    src/domain/maze_distance_matrix.cpp
+    src/domain/maze_flow_field.cpp
+    src/domain/maze_cell_weights.cpp
+    src/domain/maze_weighted_solver.cpp
+    src/domain/maze_multi_target_solver.cpp
+    src/domain/maze_landmarks.cpp
+    src/domain/maze_cluster_graph.cpp
+    src/domain/maze_solver_hierarchical.cpp
+    src/domain/maze_incremental_planner.cpp
+    src/domain/maze_solver_memoryless.cpp
     src/application/services/maze_generation.cpp
     src/application/services/maze_solver.cpp
+    src/application/services/maze_solver_fuzz.cpp
     src/infrastructure/graphics/maze_renderer.cpp
+    src/infrastructure/storage/maze_file.cpp
 )
 
 target_precompile_headers(maze_generator_app PRIVATE
@@ -35,6 +35,18 @@ void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
                                       grid_width, grid_height, algorithm_type);
 }
 
+auto generate_cell_weights(int grid_width, int grid_height, int max_weight)
+    -> CellWeights {
+  constexpr int kMaxCellWeight = 255;
+  if (max_weight < 1 || max_weight > kMaxCellWeight) {
+    std::cerr << "Warning: Terrain cost limit " << max_weight
+              << " is outside [1, " << kMaxCellWeight << "]. Clamping."
+              << std::endl;
+  }
+  return MazeDomain::generate_cell_weights(grid_height, grid_width,
+                                           max_weight);
+}
+
 auto algorithm_name(MazeAlgorithmType algorithm_type) -> std::string {
   return MazeDomain::algorithm_name(algorithm_type);
 }
@@ -5,12 +5,14 @@
 #include <string_view>
 #include <vector>
 
+#include "domain/maze_cell_weights.h"
 #include "domain/maze_generation.h"
 
 namespace MazeGeneration {
 
 using MazeAlgorithmType = MazeDomain::MazeAlgorithmType;
 using MazeGrid = MazeDomain::MazeGrid;
+using CellWeights = MazeDomain::CellWeights;
 
 // Application-layer wrapper: keeps the existing API while delegating to the
 // domain.
@@ -18,6 +20,10 @@ void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
                              int start_c, int grid_width, int grid_height,
                              MazeAlgorithmType algorithm_type);
 
+// Random terrain costs in [1, max_weight] for a grid_height x grid_width maze.
+CellWeights generate_cell_weights(int grid_width, int grid_height,
+                                  int max_weight);
+
 std::string algorithm_name(MazeAlgorithmType algorithm_type);
 bool try_parse_algorithm(std::string_view name, MazeAlgorithmType& out_type);
 std::vector<std::string> supported_algorithms();
@@ -1,6 +1,21 @@
 #include "application/services/maze_solver.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_junction_graph.h"
+#include "domain/maze_landmarks.h"
+#include "domain/maze_path_index.h"
+#include "infrastructure/storage/maze_file.h"
 
 namespace {
 
@@ -11,6 +26,271 @@ auto IsValidPosition(GridPosition pos, int height, int width) -> bool {
          pos.second < width;
 }
 
+auto BuildSolveOptions(const Config::MazeConfig& maze,
+                       std::stop_token stop_token)
+    -> MazeSolverDomain::SolveOptions {
+  MazeSolverDomain::SolveOptions options;
+  options.max_expanded_nodes =
+      static_cast<size_t>(std::max(maze.max_expanded_nodes, 0));
+  if (maze.solve_time_limit_ms > 0) {
+    options.deadline = std::chrono::steady_clock::now() +
+                       std::chrono::milliseconds(maze.solve_time_limit_ms);
+  }
+  options.stop_token = std::move(stop_token);
+  options.max_frames = static_cast<size_t>(std::max(maze.max_frames, 0));
+  options.skip_corridors = maze.skip_corridors;
+  options.landmark_count = std::max(maze.landmark_count, 0);
+  options.cluster_size = std::max(maze.cluster_size, 0);
+  options.search_threads =
+      static_cast<unsigned>(std::max(maze.search_threads, 0));
+  options.prefilter_dead_ends = maze.dead_end_prefilter;
+  options.compact_path = maze.compact_paths;
+  return options;
+}
+
+// <output_dir>/<folder>/<algorithm name, spaces as '_'><extension>, with the
+// folder created.
+auto OutputFilePath(const Config::AppConfig& config, std::string_view folder,
+                    std::string_view algorithm_name,
+                    std::string_view extension, std::string& error)
+    -> std::optional<std::filesystem::path> {
+  namespace fs = std::filesystem;
+  const fs::path kBaseDir =
+      config.output_dir.empty() ? "." : config.output_dir;
+  const fs::path kFolder = kBaseDir / folder;
+  std::error_code fs_error;
+  fs::create_directories(kFolder, fs_error);
+  if (fs_error) {
+    error = "Failed to create output directory '" + kFolder.string() +
+            "': " + fs_error.message();
+    return std::nullopt;
+  }
+  std::string file_name(algorithm_name);
+  std::replace(file_name.begin(), file_name.end(), ' ', '_');
+  return kFolder / ((file_name.empty() ? "maze" : file_name) +
+                    std::string(extension));
+}
+
+// Per-maze tables the solvers would otherwise rebuild on every call: the A*
+// landmark table, the HIERARCHICAL cluster graph, the JUNCTION_GRAPH graph
+// and the TREE_LCA path index. Each keeps the last maze it was built for,
+// keyed by the maze fingerprint and its size parameter, so every solve of
+// one maze shares a single build.
+class MazeTables {
+ public:
+  template <typename Table>
+  struct Handle {
+    std::shared_ptr<const Table> table;
+    // Time spent building the table in this call, zero when reused.
+    double build_seconds = 0.0;
+  };
+
+  auto GetLandmarks(const MazeDomain::MazeGrid& maze_data, int landmark_count)
+      -> Handle<MazeSolverDomain::LandmarkTable> {
+    return Get(landmarks_, maze_data, landmark_count, [&]() {
+      return std::make_shared<const MazeSolverDomain::LandmarkTable>(
+          MazeSolverDomain::MazeAdjacency(maze_data), landmark_count);
+    });
+  }
+
+  auto GetClusterGraph(const MazeDomain::MazeGrid& maze_data, int cluster_size)
+      -> Handle<MazeSolverDomain::ClusterGraph> {
+    return Get(cluster_graph_, maze_data, cluster_size, [&]() {
+      return std::make_shared<const MazeSolverDomain::ClusterGraph>(
+          maze_data, cluster_size, 0);
+    });
+  }
+
+  auto GetTreeIndex(const MazeDomain::MazeGrid& maze_data)
+      -> Handle<std::optional<MazeSolverDomain::TreePathIndex>> {
+    return Get(tree_index_, maze_data, 0, [&]() {
+      return std::make_shared<
+          const std::optional<MazeSolverDomain::TreePathIndex>>(
+          MazeSolverDomain::TreePathIndex::Build(maze_data));
+    });
+  }
+
+  auto GetJunctionGraph(const MazeDomain::MazeGrid& maze_data)
+      -> Handle<MazeSolverDomain::JunctionGraph> {
+    return Get(junction_graph_, maze_data, 0, [&]() {
+      return std::make_shared<const MazeSolverDomain::JunctionGraph>(
+          maze_data);
+    });
+  }
+
+ private:
+  template <typename Table>
+  struct Slot {
+    std::uint64_t fingerprint = 0;
+    int parameter = 0;
+    std::shared_ptr<const Table> table;
+  };
+
+  template <typename Table, typename Build>
+  auto Get(Slot<Table>& slot, const MazeDomain::MazeGrid& maze_data,
+           int parameter, const Build& build) -> Handle<Table> {
+    const std::uint64_t kFingerprint =
+        MazeSolverDomain::MazeFingerprint(maze_data);
+    const std::lock_guard<std::mutex> kLock(mutex_);
+    if (slot.table && slot.fingerprint == kFingerprint &&
+        slot.parameter == parameter) {
+      return {.table = slot.table};
+    }
+    const auto kBuildStart = std::chrono::steady_clock::now();
+    slot.table = build();
+    slot.fingerprint = kFingerprint;
+    slot.parameter = parameter;
+    return {.table = slot.table,
+            .build_seconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() -
+                                 kBuildStart)
+                                 .count()};
+  }
+
+  std::mutex mutex_;
+  Slot<MazeSolverDomain::LandmarkTable> landmarks_;
+  Slot<MazeSolverDomain::ClusterGraph> cluster_graph_;
+  Slot<MazeSolverDomain::JunctionGraph> junction_graph_;
+  // Empty for a maze that is not a tree, so TREE_LCA skips the build.
+  Slot<std::optional<MazeSolverDomain::TreePathIndex>> tree_index_;
+};
+
+auto SharedMazeTables() -> MazeTables& {
+  static MazeTables tables;
+  return tables;
+}
+
+// Runs the search with this maze's shared landmark table (A*), cluster graph
+// (HIERARCHICAL), junction graph (JUNCTION_GRAPH) or path index (TREE_LCA);
+// a build made for this call is reported as preprocess time.
+auto SolveWithMazeTables(const MazeDomain::MazeGrid& maze_data,
+                         const Config::MazeConfig& maze,
+                         MazeSolverDomain::SolverAlgorithmType algorithm_type,
+                         MazeSolverDomain::SolveOptions options)
+    -> MazeSolverDomain::SearchResult {
+  using MazeSolverDomain::SolverAlgorithmType;
+  MazeTables::Handle<MazeSolverDomain::LandmarkTable> landmarks;
+  MazeTables::Handle<MazeSolverDomain::ClusterGraph> cluster_graph;
+  MazeTables::Handle<MazeSolverDomain::JunctionGraph> junction_graph;
+  MazeTables::Handle<std::optional<MazeSolverDomain::TreePathIndex>>
+      tree_index;
+  if (algorithm_type == SolverAlgorithmType::ASTAR &&
+      options.landmark_count > 0) {
+    landmarks =
+        SharedMazeTables().GetLandmarks(maze_data, options.landmark_count);
+    options.landmarks = landmarks.table.get();
+  } else if (algorithm_type == SolverAlgorithmType::HIERARCHICAL) {
+    cluster_graph = SharedMazeTables().GetClusterGraph(
+        maze_data, options.cluster_size > 0
+                       ? options.cluster_size
+                       : MazeSolverDomain::ClusterGraph::kDefaultClusterSize);
+    options.cluster_graph = cluster_graph.table.get();
+  } else if (algorithm_type == SolverAlgorithmType::JUNCTION_GRAPH) {
+    junction_graph = SharedMazeTables().GetJunctionGraph(maze_data);
+    options.junction_graph = junction_graph.table.get();
+  } else if (algorithm_type == SolverAlgorithmType::TREE_LCA) {
+    tree_index = SharedMazeTables().GetTreeIndex(maze_data);
+    options.tree_index = tree_index.table.get();
+  }
+  MazeSolverDomain::SearchResult result = MazeSolverDomain::Solve(
+      maze_data, maze.start_node, maze.end_node, algorithm_type, options);
+  result.stats_.preprocess_seconds_ += landmarks.build_seconds +
+                                        cluster_graph.build_seconds +
+                                        junction_graph.build_seconds +
+                                        tree_index.build_seconds;
+  return result;
+}
+
+// One cache for every Solve() call of the process, resized from the config
+// on each call.
+auto SharedSolveCache() -> MazeSolverDomain::SolveCache& {
+  static MazeSolverDomain::SolveCache cache(0);
+  return cache;
+}
+
+// <solve_cache_dir>/<16 hex digits of the key hash>.mzs
+auto SolveCacheFilePath(const std::string& directory,
+                        const MazeSolverDomain::SolveCacheKey& key)
+    -> std::filesystem::path {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << key.Hash()
+       << ".mzs";
+  return std::filesystem::path(directory) / name.str();
+}
+
+// A cached result as returned to the caller: flagged, and with no search
+// time of its own.
+auto ServedFromCache(MazeSolverDomain::SearchResult result)
+    -> MazeSolverDomain::SearchResult {
+  result.stats_.seconds_ = 0.0;
+  result.stats_.preprocess_seconds_ = 0.0;
+  result.stats_.from_cache_ = true;
+  return result;
+}
+
+// Answers from the solve cache, then from maze.solve_cache_dir, before
+// searching; a completed search is stored in both.
+auto SolveThroughCache(const MazeDomain::MazeGrid& maze_data,
+                       const Config::MazeConfig& maze,
+                       MazeSolverDomain::SolverAlgorithmType algorithm_type,
+                       const MazeSolverDomain::SolveOptions& options,
+                       const std::string& display_name)
+    -> MazeSolverDomain::SearchResult {
+  namespace fs = std::filesystem;
+  auto& cache = SharedSolveCache();
+  constexpr size_t kBytesPerMiB = size_t{1} << 20U;
+  cache.SetCapacity(
+      static_cast<size_t>(maze.solve_cache_entries),
+      static_cast<size_t>(std::max(maze.solve_cache_max_mib, 0)) *
+          kBytesPerMiB);
+  const auto kKey = MazeSolverDomain::MakeSolveCacheKey(
+      MazeSolverDomain::MazeFingerprint(maze_data), maze.start_node,
+      maze.end_node, algorithm_type, options);
+  if (const auto kCached = cache.Find(kKey)) {
+    std::cout << display_name << ": Served from the solve cache."
+              << std::endl;
+    return ServedFromCache(*kCached);
+  }
+
+  std::optional<fs::path> file;
+  if (!maze.solve_cache_dir.empty()) {
+    file = SolveCacheFilePath(maze.solve_cache_dir, kKey);
+    std::error_code fs_error;
+    if (fs::exists(*file, fs_error)) {
+      std::string error;
+      auto stored = MazeStorage::ReadSolveCacheFile(*file, kKey, maze.height,
+                                                    maze.width, error);
+      if (stored) {
+        cache.RecordDiskHit();
+        std::cout << display_name << ": Served from solve cache file "
+                  << file->string() << std::endl;
+        cache.Insert(kKey, *stored);
+        return ServedFromCache(std::move(*stored));
+      }
+      std::cerr << display_name << ": " << error << std::endl;
+    }
+  }
+
+  MazeSolverDomain::SearchResult result =
+      SolveWithMazeTables(maze_data, maze, algorithm_type, options);
+  if (!MazeSolverDomain::IsCacheable(result)) {
+    return result;
+  }
+  if (file) {
+    std::error_code fs_error;
+    fs::create_directories(file->parent_path(), fs_error);
+    const auto kWrite = MazeStorage::WriteSolveCacheFile(
+        *file, kKey, result, maze.height, maze.width);
+    if (fs_error || !kWrite.ok) {
+      std::cerr << display_name << ": Solve cache not saved: "
+                << (fs_error ? fs_error.message() : kWrite.error)
+                << std::endl;
+    }
+  }
+  cache.Insert(kKey, result);
+  return result;
+}
+
 }  // namespace
 
 namespace MazeSolver {
@@ -29,8 +309,8 @@ auto SupportedAlgorithms() -> std::vector<std::string> {
 }
 
 auto Solve(const MazeDomain::MazeGrid& maze_data,
-           SolverAlgorithmType algorithm_type, const Config::AppConfig& config)
-    -> SearchResult {
+           SolverAlgorithmType algorithm_type, const Config::AppConfig& config,
+           std::stop_token stop_token) -> SearchResult {
   const auto& maze = config.maze;
   const std::string kSolverName =
       MazeSolverDomain::AlgorithmName(algorithm_type);
@@ -74,17 +354,370 @@ auto Solve(const MazeDomain::MazeGrid& maze_data,
               << std::endl;
   }
 
-  SearchResult result = MazeSolverDomain::Solve(maze_data, maze.start_node,
-                                                maze.end_node, algorithm_type);
+  const auto kOptions = BuildSolveOptions(maze, std::move(stop_token));
+  SearchResult result =
+      maze.solve_cache_entries > 0
+          ? SolveThroughCache(maze_data, maze, algorithm_type, kOptions,
+                              kDisplayName)
+          : SolveWithMazeTables(maze_data, maze, algorithm_type, kOptions);
 
   if (result.found_) {
-    std::cout << kDisplayName << ": Path found. Length: " << result.path_.size()
+    std::cout << kDisplayName << ": Path found. Length: " << result.PathCells()
               << std::endl;
+  } else if (result.termination_ != SearchTermination::COMPLETED) {
+    std::cout << kDisplayName << ": Stopped ("
+              << MazeSolverDomain::TerminationName(result.termination_)
+              << ") after " << result.stats_.expanded_
+              << " expanded cells. Partial path length: "
+              << result.PathCells() << std::endl;
+  } else {
+    std::cout << kDisplayName << ": Path not found." << std::endl;
+  }
+
+  return result;
+}
+
+auto SolveCacheCounters() -> SolveCacheStats {
+  return SharedSolveCache().Stats();
+}
+
+auto SolveBatch(const MazeDomain::MazeGrid& maze_data,
+                SolverAlgorithmType algorithm_type,
+                const Config::AppConfig& config, std::stop_token stop_token)
+    -> std::vector<BatchQueryResult> {
+  const auto& maze = config.maze;
+  const auto kHeightSize = static_cast<size_t>(std::max(maze.height, 0));
+  const auto kWidthSize = static_cast<size_t>(std::max(maze.width, 0));
+  if (maze_data.size() != kHeightSize ||
+      (!maze_data.empty() && maze_data.front().size() != kWidthSize)) {
+    std::cerr << "Batch queries: Maze grid dimensions do not match config. "
+                 "Aborting."
+              << std::endl;
+    return {};
+  }
+
+  const auto kBatchSolver = MazeSolverDomain::BatchSolverFor(algorithm_type);
+  if (!kBatchSolver.has_value()) {
+    std::cerr << "Batch queries: "
+              << MazeSolverDomain::AlgorithmName(algorithm_type)
+              << " has no batch mode. Skipped." << std::endl;
+    return {};
+  }
+  if (*kBatchSolver != algorithm_type) {
+    std::cout << "Batch queries: "
+              << MazeSolverDomain::AlgorithmName(algorithm_type)
+              << " runs as " << MazeSolverDomain::AlgorithmName(*kBatchSolver)
+              << "." << std::endl;
+  }
+
+  std::vector<MazeSolverDomain::QueryPair> queries;
+  queries.reserve(maze.query_pairs.size());
+  for (const auto& pair : maze.query_pairs) {
+    if (!IsValidPosition(pair.start_node, maze.height, maze.width) ||
+        !IsValidPosition(pair.end_node, maze.height, maze.width)) {
+      std::cerr << "Batch queries: (" << pair.start_node.first << ","
+                << pair.start_node.second << ") -> (" << pair.end_node.first
+                << "," << pair.end_node.second
+                << ") is out of bounds and will report not found."
+                << std::endl;
+    }
+    queries.emplace_back(pair.start_node, pair.end_node);
+  }
+
+  const auto kThreads = static_cast<unsigned>(std::max(maze.batch_threads, 0));
+  return MazeSolverDomain::SolveBatch(
+      maze_data, queries, algorithm_type, kThreads,
+      BuildSolveOptions(maze, std::move(stop_token)));
+}
+
+auto SolveWeighted(const MazeDomain::MazeGrid& maze_data,
+                   const MazeDomain::CellWeights& weights,
+                   SolverAlgorithmType algorithm_type,
+                   const Config::AppConfig& config) -> WeightedSearchResult {
+  const auto& maze = config.maze;
+  const std::string kDisplayName =
+      "Weighted " + MazeSolverDomain::AlgorithmName(algorithm_type);
+  if (weights.height() != maze.height || weights.width() != maze.width) {
+    std::cerr << kDisplayName
+              << ": Terrain weights do not match maze dimensions. Aborting."
+              << std::endl;
+    return {};
+  }
+  if (!IsValidPosition(maze.start_node, maze.height, maze.width) ||
+      !IsValidPosition(maze.end_node, maze.height, maze.width)) {
+    std::cerr << kDisplayName << ": Start or End node is out of bounds. "
+              << "Aborting." << std::endl;
+    return {};
+  }
+
+  WeightedSearchResult result = MazeSolverDomain::SolveWeighted(
+      maze_data, weights, maze.start_node, maze.end_node, algorithm_type);
+  if (result.found_) {
+    std::cout << kDisplayName << ": Path found. Length: "
+              << result.path_.size() << ", Cost: " << result.cost_
+              << ", Expanded: " << result.expanded_ << std::endl;
   } else {
     std::cout << kDisplayName << ": Path not found." << std::endl;
   }
+  return result;
+}
+
+auto SolveNearestExit(const MazeDomain::MazeGrid& maze_data,
+                      SolverAlgorithmType algorithm_type,
+                      const Config::AppConfig& config,
+                      std::stop_token stop_token) -> ExitSearchResult {
+  const auto& maze = config.maze;
+  const std::string kDisplayName =
+      "Nearest exit " + MazeSolverDomain::AlgorithmName(algorithm_type);
+  if (!IsValidPosition(maze.start_node, maze.height, maze.width)) {
+    std::cerr << kDisplayName << ": Start node is out of bounds. Aborting."
+              << std::endl;
+    return {};
+  }
+  std::vector<GridPosition> exits;
+  for (const auto& exit_node : maze.exit_nodes) {
+    if (IsValidPosition(exit_node, maze.height, maze.width)) {
+      exits.push_back(exit_node);
+    } else {
+      std::cerr << kDisplayName << ": Exit (" << exit_node.first << ","
+                << exit_node.second << ") is out of bounds. Skipping."
+                << std::endl;
+    }
+  }
 
+  const auto kOptions = BuildSolveOptions(maze, std::move(stop_token));
+  ExitSearchResult result = MazeSolverDomain::SolveNearestExit(
+      maze_data, maze.start_node, exits, algorithm_type, kOptions);
+  if (result.found_) {
+    const GridPosition& exit_node = exits[result.exit_index_];
+    std::cout << kDisplayName << ": (" << exit_node.first << ","
+              << exit_node.second << ") reached. Length: "
+              << result.path_.size()
+              << ", Expanded: " << result.stats_.expanded_ << std::endl;
+  } else if (result.termination_ != SearchTermination::COMPLETED) {
+    std::cout << kDisplayName << ": Stopped ("
+              << MazeSolverDomain::TerminationName(result.termination_)
+              << ") after " << result.stats_.expanded_ << " expanded cells."
+              << std::endl;
+  } else {
+    std::cout << kDisplayName << ": No exit reachable." << std::endl;
+  }
   return result;
 }
 
+auto ReplanAfterWallEdits(const MazeDomain::MazeGrid& maze_data,
+                          const Config::AppConfig& config) -> ReplanReport {
+  const auto& maze = config.maze;
+  ReplanReport report;
+  if (!IsValidPosition(maze.start_node, maze.height, maze.width) ||
+      !IsValidPosition(maze.end_node, maze.height, maze.width)) {
+    std::cerr << "Re-plan: Start or End node is out of bounds. Aborting."
+              << std::endl;
+    return report;
+  }
+
+  MazeSolverDomain::IncrementalPlanner planner(maze_data, maze.start_node,
+                                               maze.end_node);
+  planner.Plan();
+  report.initial = planner.Stats();
+
+  std::random_device random_device;
+  std::mt19937 engine(random_device());
+  std::uniform_int_distribution<int> row_dist(0, maze.height - 1);
+  std::uniform_int_distribution<int> col_dist(0, maze.width - 1);
+  std::uniform_int_distribution<int> wall_dist(0, MazeDomain::kWallCount - 1);
+  std::vector<MazeSolverDomain::WallToggle> toggles;
+  toggles.reserve(static_cast<size_t>(std::max(maze.replan_wall_edits, 0)));
+  for (int edit = 0; edit < maze.replan_wall_edits; ++edit) {
+    toggles.push_back({.cell = {row_dist(engine), col_dist(engine)},
+                       .wall = wall_dist(engine)});
+  }
+  report.toggles_applied = planner.ApplyWallToggles(toggles);
+
+  report.found = planner.Plan();
+  report.repair = planner.Stats();
+  report.path_length = planner.Path().size();
+
+  // The same edits against the hierarchical index: only the clusters next to
+  // a toggled wall are rebuilt.
+  using MazeSolverDomain::ClusterGraph;
+  const int kClusterSize = maze.cluster_size > 0
+                               ? maze.cluster_size
+                               : ClusterGraph::kDefaultClusterSize;
+  ClusterGraph cluster_graph(maze_data, kClusterSize, 0);
+  report.cluster_count = static_cast<size_t>(cluster_graph.ClusterCount());
+  report.clusters_rebuilt = cluster_graph.ApplyWallToggles(toggles);
+  const auto kHierarchicalPath =
+      cluster_graph.FindPath(maze.start_node, maze.end_node);
+  report.hierarchical_path_length =
+      kHierarchicalPath.found_ ? kHierarchicalPath.path_.size() : 0;
+  return report;
+}
+
+auto WalkMazeFile(const MazeDomain::MazeGrid& maze_data,
+                  std::string_view generation_algorithm_name,
+                  const Config::AppConfig& config) -> MazeFileWalkReport {
+  namespace fs = std::filesystem;
+  const auto& maze = config.maze;
+  MazeFileWalkReport report;
+  if (!IsValidPosition(maze.start_node, maze.height, maze.width) ||
+      !IsValidPosition(maze.end_node, maze.height, maze.width)) {
+    report.ok = false;
+    report.error = "Start or End node is out of bounds. Aborting.";
+    return report;
+  }
+
+  const auto kOutputPath = OutputFilePath(config, "maze_files",
+                                          generation_algorithm_name, ".mzg",
+                                          report.error);
+  if (!kOutputPath.has_value()) {
+    report.ok = false;
+    return report;
+  }
+  const fs::path& kPath = *kOutputPath;
+  report.maze_file = kPath.string();
+
+  const auto kWriteResult = MazeStorage::WriteMazeFile(kPath, maze_data);
+  if (!kWriteResult.ok) {
+    report.ok = false;
+    report.error = kWriteResult.error;
+    return report;
+  }
+  auto mapped = MazeStorage::MappedMazeFile::Open(kPath, report.error);
+  if (!mapped.has_value()) {
+    report.ok = false;
+    return report;
+  }
+
+  report.wall_follower = MazeSolverDomain::FollowWall(
+      *mapped, maze.start_node, maze.end_node, [](GridPosition) -> void {});
+  report.tremaux = MazeSolverDomain::WalkTremaux(
+      *mapped, maze.start_node, maze.end_node,
+      [&report](GridPosition) -> void { ++report.tremaux_path_length; });
+  return report;
+}
+
+auto RouteFlowFieldAgents(const MazeDomain::MazeGrid& maze_data,
+                          std::string_view generation_algorithm_name,
+                          const Config::AppConfig& config) -> FlowFieldReport {
+  const auto& maze = config.maze;
+  FlowFieldReport report;
+  if (maze_data.empty() ||
+      !IsValidPosition(maze.end_node, maze.height, maze.width)) {
+    report.ok = false;
+    report.error = "End node is out of bounds. Aborting.";
+    return report;
+  }
+  const auto kPath = OutputFilePath(config, "flow_fields",
+                                    generation_algorithm_name, ".mzf",
+                                    report.error);
+  if (!kPath.has_value()) {
+    report.ok = false;
+    return report;
+  }
+  report.flow_field_file = kPath->string();
+
+  const MazeSolverDomain::FlowField kBuilt =
+      MazeSolverDomain::BuildFlowField(maze_data, maze.end_node);
+  report.build = kBuilt.stats_;
+  report.field_bytes = kBuilt.Bytes();
+  const auto kWriteResult = MazeStorage::WriteFlowFieldFile(*kPath, kBuilt);
+  if (!kWriteResult.ok) {
+    report.ok = false;
+    report.error = kWriteResult.error;
+    return report;
+  }
+  const auto kField = MazeStorage::ReadFlowFieldFile(*kPath, report.error);
+  if (!kField.has_value()) {
+    report.ok = false;
+    return report;
+  }
+
+  std::random_device random_device;
+  std::mt19937 engine(random_device());
+  std::uniform_int_distribution<int> row_dist(0, kField->height_ - 1);
+  std::uniform_int_distribution<int> col_dist(0, kField->width_ - 1);
+  report.agents = static_cast<size_t>(std::max(maze.flow_field_agents, 0));
+  std::vector<GridPosition> starts;
+  starts.reserve(report.agents);
+  for (size_t agent = 0; agent < report.agents; ++agent) {
+    starts.emplace_back(row_dist(engine), col_dist(engine));
+  }
+
+  const auto kStartTime = std::chrono::steady_clock::now();
+  for (const GridPosition& start : starts) {
+    const auto kAgentPath = MazeSolverDomain::FollowFlowField(*kField, start);
+    if (kAgentPath.empty()) {
+      continue;
+    }
+    ++report.agents_reached;
+    report.total_steps += kAgentPath.size() - 1;
+    report.longest_steps =
+        std::max(report.longest_steps, kAgentPath.size() - 1);
+  }
+  report.route_seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - kStartTime)
+                             .count();
+  return report;
+}
+
+auto ComputeDistanceField(const MazeDomain::MazeGrid& maze_data,
+                          const Config::AppConfig& config) -> DistanceField {
+  const auto& maze = config.maze;
+  const auto kHeightSize = static_cast<size_t>(std::max(maze.height, 0));
+  const auto kWidthSize = static_cast<size_t>(std::max(maze.width, 0));
+  if (maze_data.size() != kHeightSize ||
+      (!maze_data.empty() && maze_data.front().size() != kWidthSize)) {
+    std::cerr << "Distance field: Maze grid dimensions do not match config. "
+                 "Aborting."
+              << std::endl;
+    return {};
+  }
+  if (!IsValidPosition(maze.start_node, maze.height, maze.width)) {
+    std::cerr << "Distance field: Start node is out of bounds. Aborting."
+              << std::endl;
+    return {};
+  }
+
+  const auto kThreads =
+      static_cast<unsigned>(std::max(maze.distance_field_threads, 0));
+  return MazeSolverDomain::ComputeDistanceField(maze_data, maze.start_node,
+                                                kThreads);
+}
+
+auto PointsOfInterest(const Config::AppConfig& config)
+    -> std::vector<GridPosition> {
+  const auto& maze = config.maze;
+  std::vector<GridPosition> points = {maze.start_node, maze.end_node};
+  points.insert(points.end(), maze.exit_nodes.begin(), maze.exit_nodes.end());
+  for (const auto& query : maze.query_pairs) {
+    points.push_back(query.start_node);
+    points.push_back(query.end_node);
+  }
+  return points;
+}
+
+auto ComputeDistanceMatrix(const MazeDomain::MazeGrid& maze_data,
+                           const Config::AppConfig& config) -> DistanceMatrix {
+  const std::vector<GridPosition> kPoints = PointsOfInterest(config);
+  const auto kThreads =
+      static_cast<unsigned>(std::max(config.maze.distance_field_threads, 0));
+  return MazeSolverDomain::ComputeDistanceMatrix(maze_data, kPoints, kPoints,
+                                                 kThreads);
+}
+
+auto FindHardestEndpoints(const MazeDomain::MazeGrid& maze_data,
+                          const Config::AppConfig& config)
+    -> DiameterEndpoints {
+  const auto& maze = config.maze;
+  const GridPosition kSeed =
+      IsValidPosition(maze.start_node, maze.height, maze.width)
+          ? maze.start_node
+          : GridPosition{0, 0};
+  const auto kThreads =
+      static_cast<unsigned>(std::max(maze.distance_field_threads, 0));
+  return MazeSolverDomain::FindDiameterEndpoints(
+      MazeSolverDomain::MazeAdjacency(maze_data), kSeed, kThreads);
+}
+
 }  // namespace MazeSolver
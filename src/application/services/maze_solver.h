@@ -1,25 +1,154 @@
 #ifndef MAZE_SOLVER_H
 #define MAZE_SOLVER_H
 
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "config/config.h"
+#include "domain/maze_batch_solver.h"
+#include "domain/maze_cell_weights.h"
+#include "domain/maze_cluster_graph.h"
+#include "domain/maze_distance_field.h"
+#include "domain/maze_distance_matrix.h"
+#include "domain/maze_flow_field.h"
 #include "domain/maze_grid.h"
+#include "domain/maze_incremental_planner.h"
+#include "domain/maze_memoryless_solver.h"
+#include "domain/maze_multi_target_solver.h"
+#include "domain/maze_solve_cache.h"
 #include "domain/maze_solver.h"
+#include "domain/maze_weighted_solver.h"
 
 namespace MazeSolver {
 
 using SolverAlgorithmType = MazeSolverDomain::SolverAlgorithmType;
 using SearchResult = MazeSolverDomain::SearchResult;
+using SearchTermination = MazeSolverDomain::SearchTermination;
+using BatchQueryResult = MazeSolverDomain::BatchQueryResult;
+using DistanceField = MazeSolverDomain::DistanceField;
+using DistanceMatrix = MazeSolverDomain::DistanceMatrix;
+using DiameterEndpoints = MazeSolverDomain::DiameterEndpoints;
+using WeightedSearchResult = MazeSolverDomain::WeightedSearchResult;
+using PlannerStats = MazeSolverDomain::PlannerStats;
+using WalkResult = MazeSolverDomain::WalkResult;
+using ExitSearchResult = MazeSolverDomain::ExitSearchResult;
+using FlowFieldStats = MazeSolverDomain::FlowFieldStats;
+using SolveCacheStats = MazeSolverDomain::SolveCacheStats;
+
+struct ReplanReport {
+  PlannerStats initial;
+  PlannerStats repair;
+  size_t toggles_applied = 0;
+  bool found = false;
+  size_t path_length = 0;
+  // ClusterGraph over the same maze and edits.
+  size_t cluster_count = 0;
+  size_t clusters_rebuilt = 0;
+  size_t hierarchical_path_length = 0;
+};
+
+struct MazeFileWalkReport {
+  bool ok = true;
+  std::string error;
+  std::string maze_file;
+  WalkResult wall_follower;
+  WalkResult tremaux;
+  size_t tremaux_path_length = 0;
+};
+
+struct FlowFieldReport {
+  bool ok = true;
+  std::string error;
+  std::string flow_field_file;
+  FlowFieldStats build;
+  size_t field_bytes = 0;
+  size_t agents = 0;
+  size_t agents_reached = 0;
+  size_t total_steps = 0;
+  size_t longest_steps = 0;
+  double route_seconds = 0.0;
+};
 
 std::string AlgorithmName(SolverAlgorithmType algorithm_type);
 bool TryParseAlgorithm(std::string_view name, SolverAlgorithmType& out_type);
 std::vector<std::string> SupportedAlgorithms();
 
+// Bounded by config.maze.max_expanded_nodes / solve_time_limit_ms /
+// max_frames; `stop_token` cancels the search from another thread. With
+// config.maze.solve_cache_entries a repeated query (same walls, endpoints,
+// solver and options) is answered from the process-wide solve cache, or from
+// config.maze.solve_cache_dir, without searching; such results carry
+// stats_.from_cache_ and a search time of zero.
 SearchResult Solve(const MazeDomain::MazeGrid& maze_data,
                    SolverAlgorithmType algorithm_type,
-                   const Config::AppConfig& config);
+                   const Config::AppConfig& config,
+                   std::stop_token stop_token = {});
+
+// Hit / miss counters of the cache behind Solve().
+SolveCacheStats SolveCacheCounters();
+
+// Answers config.maze.query_pairs against one maze, results in input order.
+std::vector<BatchQueryResult> SolveBatch(const MazeDomain::MazeGrid& maze_data,
+                                         SolverAlgorithmType algorithm_type,
+                                         const Config::AppConfig& config,
+                                         std::stop_token stop_token = {});
+
+// Cheapest start -> end path over terrain weights (Dijkstra, or A* for ASTAR).
+WeightedSearchResult SolveWeighted(const MazeDomain::MazeGrid& maze_data,
+                                   const MazeDomain::CellWeights& weights,
+                                   SolverAlgorithmType algorithm_type,
+                                   const Config::AppConfig& config);
+
+// Nearest of config.maze.exit_nodes from the start node in one search; out of
+// bounds exits are skipped with a warning.
+ExitSearchResult SolveNearestExit(const MazeDomain::MazeGrid& maze_data,
+                                  SolverAlgorithmType algorithm_type,
+                                  const Config::AppConfig& config,
+                                  std::stop_token stop_token = {});
+
+// Plans start -> end with IncrementalPlanner, toggles
+// config.maze.replan_wall_edits random interior walls and re-plans; the same
+// toggles are applied to a ClusterGraph, which rebuilds only the touched
+// clusters before answering the query again.
+ReplanReport ReplanAfterWallEdits(const MazeDomain::MazeGrid& maze_data,
+                                  const Config::AppConfig& config);
+
+// Writes the maze to a packed file under config.output_dir, memory-maps it and
+// runs the wall follower and Trémaux walkers on the mapping, so neither ever
+// sees the in-memory grid.
+MazeFileWalkReport WalkMazeFile(const MazeDomain::MazeGrid& maze_data,
+                                std::string_view generation_algorithm_name,
+                                const Config::AppConfig& config);
+
+// Builds a flow field to config.maze.end_node, writes it under
+// config.output_dir and reads it back, then routes
+// config.maze.flow_field_agents agents from random cells by following the
+// reloaded field.
+FlowFieldReport RouteFlowFieldAgents(const MazeDomain::MazeGrid& maze_data,
+                                     std::string_view generation_algorithm_name,
+                                     const Config::AppConfig& config);
+
+// BFS distances from config.maze.start_node to every cell, using
+// config.maze.distance_field_threads workers.
+DistanceField ComputeDistanceField(const MazeDomain::MazeGrid& maze_data,
+                                   const Config::AppConfig& config);
+
+// Start, end, config.maze.exit_nodes and both ends of every query pair, in
+// that order; out of bounds points are kept and stay unreached.
+std::vector<MazeSolverDomain::GridPosition> PointsOfInterest(
+    const Config::AppConfig& config);
+
+// All-pairs BFS distances between PointsOfInterest(), using
+// config.maze.distance_field_threads workers.
+DistanceMatrix ComputeDistanceMatrix(const MazeDomain::MazeGrid& maze_data,
+                                     const Config::AppConfig& config);
+
+// Double-sweep BFS seeded at config.maze.start_node ((0,0) if out of bounds),
+// using config.maze.distance_field_threads workers.
+DiameterEndpoints FindHardestEndpoints(const MazeDomain::MazeGrid& maze_data,
+                                       const Config::AppConfig& config);
 
 }  // namespace MazeSolver
 
@@ -0,0 +1,381 @@
+#include "application/services/maze_solver_fuzz.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string_view>
+
+#include "domain/maze_generation.h"
+#include "domain/maze_solver.h"
+#include "infrastructure/storage/maze_file.h"
+
+namespace {
+
+using GridPosition = MazeSolverDomain::GridPosition;
+using MazeSolverDomain::SolverAlgorithmType;
+
+// Below these a solve, or the BFS it is measured against, is too short to
+// time or expands too few cells to compare; ratios to a near-zero BFS
+// baseline (endpoints a few cells apart) would swamp the real outliers.
+constexpr double kMinTimedSeconds = 50e-6;
+constexpr size_t kMinComparedExpansions = 64;
+// Ratios a solver needs before its median counts as typical.
+constexpr size_t kWarmupRatios = 16;
+constexpr int kLandmarkCount = 4;
+
+auto PromisesShortestPath(SolverAlgorithmType type) -> bool {
+  switch (type) {
+    case SolverAlgorithmType::BFS:
+    case SolverAlgorithmType::BITBOARD_BFS:
+    case SolverAlgorithmType::ASTAR:
+    case SolverAlgorithmType::PARALLEL_ASTAR:
+    case SolverAlgorithmType::DIJKSTRA:
+    case SolverAlgorithmType::JUNCTION_GRAPH:
+    case SolverAlgorithmType::TREE_LCA:
+    case SolverAlgorithmType::HIERARCHICAL:
+    case SolverAlgorithmType::DEAD_END_FILLING:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The wall follower keeps a hand on one connected wall component. Loops
+// split the walls into several components, and an end beside another one is
+// never reached even though a path exists.
+auto IsComplete(SolverAlgorithmType type) -> bool {
+  return type != SolverAlgorithmType::WALL_FOLLOWER;
+}
+
+// Knocks down each interior wall with probability `loop_chance`.
+void BraidMaze(MazeDomain::MazeGrid& maze_grid, double loop_chance,
+               std::mt19937& engine) {
+  std::bernoulli_distribution knock_down(loop_chance);
+  const size_t kHeight = maze_grid.size();
+  for (size_t row = 0; row < kHeight; ++row) {
+    const size_t kWidth = maze_grid[row].size();
+    for (size_t col = 0; col < kWidth; ++col) {
+      if (col + 1 < kWidth && knock_down(engine)) {
+        maze_grid[row][col].walls[1] = false;
+        maze_grid[row][col + 1].walls[3] = false;
+      }
+      if (row + 1 < kHeight && knock_down(engine)) {
+        maze_grid[row][col].walls[2] = false;
+        maze_grid[row + 1][col].walls[0] = false;
+      }
+    }
+  }
+}
+
+// Generated mazes are connected, so they are perfect (one path between any
+// two cells) exactly when they have one passage fewer than cells.
+auto IsPerfect(const MazeDomain::MazeGrid& maze_grid) -> bool {
+  size_t cells = 0;
+  size_t passages = 0;
+  for (const auto& row : maze_grid) {
+    for (const auto& cell : row) {
+      ++cells;
+      passages += static_cast<size_t>(!cell.walls[1]) +
+                  static_cast<size_t>(!cell.walls[2]);
+    }
+  }
+  return passages + 1 == cells;
+}
+
+auto IsValidWalk(const MazeDomain::MazeGrid& maze_grid,
+                 const std::vector<GridPosition>& path, GridPosition start,
+                 GridPosition end) -> bool {
+  if (path.empty() || path.front() != start || path.back() != end) {
+    return false;
+  }
+  for (size_t index = 0; index + 1 < path.size(); ++index) {
+    const auto [row, col] = path[index];
+    const int kRowStep = path[index + 1].first - row;
+    const int kColStep = path[index + 1].second - col;
+    if (std::abs(kRowStep) + std::abs(kColStep) != 1) {
+      return false;
+    }
+    const int kWall = kRowStep < 0   ? 0
+                      : kColStep > 0 ? 1
+                      : kRowStep > 0 ? 2
+                                     : 3;
+    if (maze_grid[static_cast<size_t>(row)][static_cast<size_t>(col)]
+            .walls[kWall]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Empty when `result` keeps its solver's promises, else what it broke.
+auto CheckResult(const MazeDomain::MazeGrid& maze_grid, GridPosition start,
+                 GridPosition end, SolverAlgorithmType type,
+                 const MazeSolverDomain::SearchResult& result,
+                 const std::vector<GridPosition>& path,
+                 const MazeSolverDomain::SearchResult& reference,
+                 bool perfect) -> std::string {
+  if (result.termination_ != MazeSolverDomain::SearchTermination::COMPLETED) {
+    return "stopped without limits (" +
+           std::string(MazeSolverDomain::TerminationName(result.termination_)) +
+           ")";
+  }
+  if (result.found_ && !IsValidWalk(maze_grid, path, start, end)) {
+    return "path is not a valid start -> end walk";
+  }
+  if ((IsComplete(type) || perfect) && result.found_ != reference.found_) {
+    return std::string(result.found_ ? "found" : "missed") +
+           " a path where BFS " + (reference.found_ ? "found one" : "did not");
+  }
+  if (!result.found_ || !reference.found_) {
+    return {};
+  }
+  const bool kMustBeShortest = PromisesShortestPath(type) || perfect;
+  if (path.size() < reference.path_.size() ||
+      (kMustBeShortest && path.size() != reference.path_.size())) {
+    return "path has " + std::to_string(path.size()) + " cells, BFS " +
+           std::to_string(reference.path_.size());
+  }
+  return {};
+}
+
+// TOML fragment with the MazeConfig keys that replay the case on the saved
+// maze: size, endpoints and the SolveOptions every solver ran with.
+auto CaseConfig(int case_index, std::string_view generator, int height,
+                int width, GridPosition start, GridPosition end,
+                const MazeSolverDomain::SolveOptions& options) -> std::string {
+  const auto kBool = [](bool value) { return value ? "true" : "false"; };
+  std::string text = "# Fuzz case " + std::to_string(case_index) + " (" +
+                     std::string(generator) + ")\n[MazeConfig]\n";
+  text += "MazeHeight = " + std::to_string(height) + "\n";
+  text += "MazeWidth = " + std::to_string(width) + "\n";
+  text += "StartNodeY = " + std::to_string(start.first) + "\n";
+  text += "StartNodeX = " + std::to_string(start.second) + "\n";
+  text += "EndNodeY = " + std::to_string(end.first) + "\n";
+  text += "EndNodeX = " + std::to_string(end.second) + "\n";
+  text += "SkipCorridors = " + std::string(kBool(options.skip_corridors)) +
+          "\n";
+  text += "DeadEndPrefilter = " +
+          std::string(kBool(options.prefilter_dead_ends)) + "\n";
+  text += "CompactPaths = " + std::string(kBool(options.compact_path)) + "\n";
+  text += "LandmarkCount = " + std::to_string(options.landmark_count) + "\n";
+  return text;
+}
+
+auto Median(std::vector<double> values) -> double {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const auto kMiddle =
+      values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+  std::nth_element(values.begin(), kMiddle, values.end());
+  return *kMiddle;
+}
+
+struct SolverTrack {
+  SolverAlgorithmType type = SolverAlgorithmType::BFS;
+  MazeSolver::FuzzSolverSummary summary;
+  std::vector<double> time_ratios;
+  std::vector<double> expanded_ratios;
+};
+
+}  // namespace
+
+namespace MazeSolver {
+
+auto FuzzSolvers(const FuzzOptions& options) -> FuzzReport {
+  namespace fs = std::filesystem;
+  FuzzReport report;
+  if (options.cases < 0 || options.min_size < 1 ||
+      options.max_size < options.min_size ||
+      options.large_max_size < options.max_size || options.large_every < 0 ||
+      options.slow_factor <= 1.0) {
+    report.ok = false;
+    report.error =
+        "Fuzz needs cases >= 0, 1 <= min size <= max size <= large max size, "
+        "large every >= 0 and a slow factor above 1.";
+    return report;
+  }
+  const fs::path kFuzzDir =
+      fs::path(options.output_dir.empty() ? "." : options.output_dir) / "fuzz";
+  std::error_code fs_error;
+  fs::create_directories(kFuzzDir, fs_error);
+  if (fs_error) {
+    report.ok = false;
+    report.error = "Failed to create output directory '" + kFuzzDir.string() +
+                   "': " + fs_error.message();
+    return report;
+  }
+  report.cases_file = (kFuzzDir / "fuzz_cases.csv").string();
+  std::ofstream cases_csv(report.cases_file, std::ios::trunc);
+  if (!cases_csv) {
+    report.ok = false;
+    report.error = "Failed to open " + report.cases_file;
+    return report;
+  }
+  cases_csv << "case,generator,height,width,perfect,start_row,start_col,"
+               "end_row,end_col,skip_corridors,prefilter_dead_ends,"
+               "compact_path,landmark_count,solver,found,path_cells,expanded,"
+               "seconds\n";
+
+  std::vector<MazeDomain::MazeAlgorithmType> generators;
+  for (const auto& name : MazeDomain::supported_algorithms()) {
+    MazeDomain::MazeAlgorithmType type{};
+    if (MazeDomain::try_parse_algorithm(name, type)) {
+      generators.push_back(type);
+    }
+  }
+  std::vector<SolverTrack> tracks;
+  for (const auto& name : MazeSolverDomain::supported_algorithms()) {
+    SolverTrack track;
+    if (MazeSolverDomain::TryParseAlgorithm(name, track.type)) {
+      track.summary.solver = name;
+      tracks.push_back(std::move(track));
+    }
+  }
+  if (generators.empty() || tracks.empty()) {
+    report.ok = false;
+    report.error = "No maze generators or solvers are registered.";
+    return report;
+  }
+
+  std::mt19937 engine(options.seed);
+  std::uniform_int_distribution<int> size_dist(options.min_size,
+                                               options.max_size);
+  std::uniform_int_distribution<int> large_size_dist(options.max_size,
+                                                     options.large_max_size);
+  std::uniform_real_distribution<double> loop_dist(0.02, 0.3);
+  std::bernoulli_distribution coin(0.5);
+  MazeSolverDomain::SolveOptions reference_options;
+  reference_options.record_frames = false;
+
+  for (int case_index = 0; case_index < options.cases; ++case_index) {
+    const auto kGenerator =
+        generators[static_cast<size_t>(case_index) % generators.size()];
+    const std::string kGeneratorName = MazeDomain::algorithm_name(kGenerator);
+    const bool kLarge = options.large_every > 0 &&
+                        (case_index + 1) % options.large_every == 0;
+    auto& dims_dist = kLarge ? large_size_dist : size_dist;
+    const int kHeight = dims_dist(engine);
+    const int kWidth = dims_dist(engine);
+    MazeDomain::MazeGrid maze_grid(
+        static_cast<size_t>(kHeight),
+        std::vector<MazeDomain::MazeCell>(static_cast<size_t>(kWidth)));
+    MazeDomain::generate_maze_structure(maze_grid, 0, 0, kWidth, kHeight,
+                                        kGenerator, engine);
+    if (coin(engine)) {
+      BraidMaze(maze_grid, loop_dist(engine), engine);
+    }
+    const bool kPerfect = IsPerfect(maze_grid);
+    std::uniform_int_distribution<int> row_dist(0, kHeight - 1);
+    std::uniform_int_distribution<int> col_dist(0, kWidth - 1);
+    const GridPosition kStart = {row_dist(engine), col_dist(engine)};
+    const GridPosition kEnd = {row_dist(engine), col_dist(engine)};
+    MazeSolverDomain::SolveOptions case_options = reference_options;
+    case_options.skip_corridors = coin(engine);
+    case_options.prefilter_dead_ends = coin(engine);
+    case_options.compact_path = coin(engine);
+    case_options.landmark_count = coin(engine) ? kLandmarkCount : 0;
+
+    // Written once, the first time the case is flagged, with the case's
+    // endpoints and options beside it in case_<n>.toml.
+    std::string maze_file;
+    const auto kSaveMaze = [&]() -> std::string {
+      if (maze_file.empty()) {
+        const std::string kStem = "case_" + std::to_string(case_index);
+        const fs::path kPath = kFuzzDir / (kStem + ".mzg");
+        std::ofstream case_config(kFuzzDir / (kStem + ".toml"),
+                                  std::ios::trunc);
+        case_config << CaseConfig(case_index, kGeneratorName, kHeight, kWidth,
+                                  kStart, kEnd, case_options);
+        if (case_config && MazeStorage::WriteMazeFile(kPath, maze_grid).ok) {
+          maze_file = kPath.string();
+        }
+      }
+      return maze_file;
+    };
+
+    // The queue BFS itself, not the bitboard BFS Solve() may swap in,
+    // which is one of the solvers under test.
+    MazeSolverDomain::SolveOptions queue_bfs_options = reference_options;
+    queue_bfs_options.allow_bitboard_bfs = false;
+    const auto kReference = MazeSolverDomain::Solve(
+        maze_grid, kStart, kEnd, SolverAlgorithmType::BFS, queue_bfs_options);
+    ++report.solves;
+    for (auto& track : tracks) {
+      const auto kResult = MazeSolverDomain::Solve(maze_grid, kStart, kEnd,
+                                                   track.type, case_options);
+      ++report.solves;
+      const std::vector<GridPosition> kPath =
+          kResult.compact_path_.Empty() ? kResult.path_
+                                        : kResult.compact_path_.ToPath();
+      const std::string kProblem =
+          CheckResult(maze_grid, kStart, kEnd, track.type, kResult, kPath,
+                      kReference, kPerfect);
+      if (!kProblem.empty()) {
+        report.failures.push_back({.case_index = case_index,
+                                   .generator = kGeneratorName,
+                                   .solver = track.summary.solver,
+                                   .message = kProblem,
+                                   .maze_file = kSaveMaze()});
+      }
+
+      const auto& stats = kResult.stats_;
+      cases_csv << case_index << ',' << kGeneratorName << ',' << kHeight << ','
+                << kWidth << ',' << kPerfect << ',' << kStart.first << ','
+                << kStart.second << ',' << kEnd.first << ',' << kEnd.second
+                << ',' << case_options.skip_corridors << ','
+                << case_options.prefilter_dead_ends << ','
+                << case_options.compact_path << ','
+                << case_options.landmark_count << ','
+                << track.summary.solver << ',' << kResult.found_ << ','
+                << kPath.size() << ',' << stats.expanded_ << ','
+                << stats.seconds_ << '\n';
+      ++track.summary.runs;
+      track.summary.seconds += stats.seconds_;
+      track.summary.expanded += stats.expanded_;
+
+      const auto kCompare = [&](std::vector<double>& ratios, double ratio,
+                                const char* metric) {
+        if (ratios.size() >= kWarmupRatios) {
+          const double kTypical = Median(ratios);
+          if (ratio > options.slow_factor * kTypical) {
+            report.outliers.push_back({.case_index = case_index,
+                                       .solver = track.summary.solver,
+                                       .metric = metric,
+                                       .ratio = ratio,
+                                       .typical_ratio = kTypical,
+                                       .height = kHeight,
+                                       .width = kWidth,
+                                       .maze_file = kSaveMaze()});
+          }
+        }
+        ratios.push_back(ratio);
+      };
+      if (stats.seconds_ >= kMinTimedSeconds &&
+          kReference.stats_.seconds_ >= kMinTimedSeconds) {
+        kCompare(track.time_ratios,
+                 stats.seconds_ / kReference.stats_.seconds_, "time");
+      }
+      if (stats.expanded_ >= kMinComparedExpansions &&
+          kReference.stats_.expanded_ >= kMinComparedExpansions) {
+        kCompare(track.expanded_ratios,
+                 static_cast<double>(stats.expanded_) /
+                     static_cast<double>(kReference.stats_.expanded_),
+                 "expanded");
+      }
+    }
+    ++report.cases;
+  }
+
+  for (auto& track : tracks) {
+    track.summary.median_time_ratio = Median(std::move(track.time_ratios));
+    track.summary.median_expanded_ratio =
+        Median(std::move(track.expanded_ratios));
+    report.solvers.push_back(std::move(track.summary));
+  }
+  return report;
+}
+
+}  // namespace MazeSolver
@@ -0,0 +1,86 @@
+#ifndef MAZE_SOLVER_FUZZ_H
+#define MAZE_SOLVER_FUZZ_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MazeSolver {
+
+struct FuzzOptions {
+  int cases = 200;
+  std::uint32_t seed = 1;
+  // Height and width are drawn from [min_size, max_size] independently.
+  int min_size = 2;
+  int max_size = 64;
+  // Every large_every-th case draws them from [max_size, large_max_size]
+  // instead, so mazes span many hierarchical clusters; 0 turns this off.
+  int large_every = 8;
+  int large_max_size = 256;
+  // A solver is flagged on a case where its time or expansions, relative to
+  // BFS on the same case, exceed slow_factor times its median ratio so far.
+  double slow_factor = 8.0;
+  // Flagged mazes and fuzz_cases.csv go to <output_dir>/fuzz.
+  std::string output_dir = ".";
+};
+
+struct FuzzFailure {
+  int case_index = 0;
+  std::string generator;
+  std::string solver;
+  std::string message;
+  std::string maze_file;
+};
+
+struct FuzzOutlier {
+  int case_index = 0;
+  std::string solver;
+  // "time" or "expanded".
+  std::string metric;
+  double ratio = 0.0;
+  double typical_ratio = 0.0;
+  int height = 0;
+  int width = 0;
+  std::string maze_file;
+};
+
+struct FuzzSolverSummary {
+  std::string solver;
+  size_t runs = 0;
+  double seconds = 0.0;
+  size_t expanded = 0;
+  // Medians of time and expansions relative to BFS on the same case.
+  double median_time_ratio = 0.0;
+  double median_expanded_ratio = 0.0;
+};
+
+struct FuzzReport {
+  bool ok = true;
+  std::string error;
+  int cases = 0;
+  size_t solves = 0;
+  std::string cases_file;
+  std::vector<FuzzSolverSummary> solvers;
+  std::vector<FuzzFailure> failures;
+  std::vector<FuzzOutlier> outliers;
+};
+
+// Differential fuzzing: every case generates a maze with the next generator
+// in turn, at a random size, braids loops into half of them and picks random
+// endpoints and SolveOptions (corridor skipping, dead-end prefilter, compact
+// paths, landmarks). Every registered solver then runs on it. A case fails
+// when a path is not a valid start -> end walk, when a solver that promises
+// shortest paths disagrees with BFS on the length, when a complete solver
+// disagrees with BFS on reachability, or when any solver returns a longer
+// path on a perfect maze. The reference is the queue BFS
+// (SolveOptions::allow_bitboard_bfs off), never the bitboard BFS. Mazes come
+// from an engine seeded with `seed`, so a run is reproducible. Each solve is
+// logged with the case's options to fuzz_cases.csv; mazes behind failures and
+// outliers are written as packed maze files, each with a case_<n>.toml of its
+// endpoints and options.
+FuzzReport FuzzSolvers(const FuzzOptions& options);
+
+}  // namespace MazeSolver
+
+#endif  // MAZE_SOLVER_FUZZ_H
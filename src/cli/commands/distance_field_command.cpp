@@ -0,0 +1,51 @@
+#include "cli/commands/distance_field_command.h"
+
+#include <exception>
+
+namespace Cli {
+
+namespace {
+
+auto HandleDistanceField(const std::vector<std::string>& args,
+                         CommandContext& ctx) -> int {
+  if (args.empty()) {
+    ctx.out << "DistanceField: "
+            << (ctx.config.maze.distance_field ? "on" : "off") << "\n";
+    ctx.out << "DistanceFieldThreads: "
+            << ctx.config.maze.distance_field_threads << "\n";
+    return 0;
+  }
+  return ApplyDistanceField(args.front(), ctx);
+}
+
+}  // namespace
+
+auto ApplyDistanceField(const std::string& value, CommandContext& ctx)
+    -> int {
+  try {
+    const int kThreads = std::stoi(value);
+    if (kThreads < 0) {
+      ctx.err << "DistanceFieldThreads must be >= 0 (0 = all hardware "
+                 "threads).\n";
+      return 1;
+    }
+    ctx.config.maze.distance_field = true;
+    ctx.config.maze.distance_field_threads = kThreads;
+  } catch (const std::exception&) {
+    ctx.err << "Invalid DistanceFieldThreads value: " << value << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+void RegisterDistanceFieldCommand(CliApp& app) {
+  Command command;
+  command.name = "distance-field";
+  command.description =
+      "Show the distance field settings, or enable it with <n> threads";
+  command.handler = HandleDistanceField;
+  command.exit_after = true;
+  app.register_command(std::move(command));
+}
+
+}  // namespace Cli
@@ -0,0 +1,14 @@
+#ifndef DISTANCE_FIELD_COMMAND_H
+#define DISTANCE_FIELD_COMMAND_H
+
+#include "cli/framework/cli_app.h"
+
+namespace Cli {
+
+void RegisterDistanceFieldCommand(CliApp& app);
+// Enables the distance field and sets its worker count.
+int ApplyDistanceField(const std::string& value, CommandContext& ctx);
+
+}  // namespace Cli
+
+#endif  // DISTANCE_FIELD_COMMAND_H
@@ -0,0 +1,110 @@
+#include "cli/commands/fuzz_command.h"
+
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+
+#include "application/services/maze_solver_fuzz.h"
+
+namespace Cli {
+
+namespace {
+
+// Fills cases, seed, max size and large max size from up to four positional
+// arguments.
+auto ParseFuzzArgs(const std::vector<std::string>& args,
+                   MazeSolver::FuzzOptions& options, std::string& error)
+    -> bool {
+  if (args.size() > 4) {
+    error = "Usage: fuzz [cases [seed [max_size [large_max_size]]]]";
+    return false;
+  }
+  try {
+    if (!args.empty()) {
+      options.cases = std::stoi(args[0]);
+    }
+    if (args.size() > 1) {
+      options.seed = static_cast<std::uint32_t>(std::stoul(args[1]));
+    }
+    if (args.size() > 2) {
+      options.max_size = std::stoi(args[2]);
+      options.large_max_size = std::max(options.large_max_size,
+                                        options.max_size);
+    }
+    if (args.size() > 3) {
+      options.large_max_size = std::stoi(args[3]);
+    }
+  } catch (const std::exception&) {
+    error =
+        "Invalid fuzz argument; usage: fuzz [cases [seed [max_size "
+        "[large_max_size]]]]";
+    return false;
+  }
+  return true;
+}
+
+void PrintFuzzReport(const MazeSolver::FuzzReport& report, std::ostream& out) {
+  out << "Fuzzed " << report.cases << " cases, " << report.solves
+      << " solves; per-solve log in " << report.cases_file << "\n";
+  out << std::fixed;
+  for (const auto& solver : report.solvers) {
+    out << "  " << std::left << std::setw(20) << solver.solver << std::right
+        << std::setprecision(4) << solver.seconds << " s, "
+        << solver.expanded << " expanded, median vs BFS: time x"
+        << std::setprecision(2) << solver.median_time_ratio << ", expanded x"
+        << solver.median_expanded_ratio << "\n";
+  }
+  for (const auto& failure : report.failures) {
+    out << "FAIL case " << failure.case_index << " (" << failure.generator
+        << ") " << failure.solver << ": " << failure.message;
+    if (!failure.maze_file.empty()) {
+      out << " [" << failure.maze_file << "]";
+    }
+    out << "\n";
+  }
+  for (const auto& outlier : report.outliers) {
+    out << "SLOW case " << outlier.case_index << " (" << outlier.height << "x"
+        << outlier.width << ") " << outlier.solver << ": " << outlier.metric
+        << " x" << std::setprecision(2) << outlier.ratio << " of BFS, typical x"
+        << outlier.typical_ratio;
+    if (!outlier.maze_file.empty()) {
+      out << " [" << outlier.maze_file << "]";
+    }
+    out << "\n";
+  }
+  out << report.failures.size() << " failures, " << report.outliers.size()
+      << " performance outliers.\n";
+}
+
+auto HandleFuzz(const std::vector<std::string>& args, CommandContext& ctx)
+    -> int {
+  MazeSolver::FuzzOptions options;
+  options.output_dir = ctx.config.output_dir;
+  std::string error;
+  if (!ParseFuzzArgs(args, options, error)) {
+    ctx.err << error << "\n";
+    return 1;
+  }
+  const auto kReport = MazeSolver::FuzzSolvers(options);
+  if (!kReport.ok) {
+    ctx.err << kReport.error << "\n";
+    return 1;
+  }
+  PrintFuzzReport(kReport, ctx.out);
+  return kReport.failures.empty() ? 0 : 1;
+}
+
+}  // namespace
+
+void RegisterFuzzCommand(CliApp& app) {
+  Command command;
+  command.name = "fuzz";
+  command.description =
+      "Cross-check every solver on random mazes: fuzz [cases [seed "
+      "[max_size [large_max_size]]]]";
+  command.handler = HandleFuzz;
+  command.exit_after = true;
+  app.register_command(std::move(command));
+}
+
+}  // namespace Cli
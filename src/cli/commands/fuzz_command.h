@@ -0,0 +1,14 @@
+#ifndef FUZZ_COMMAND_H
+#define FUZZ_COMMAND_H
+
+#include "cli/framework/cli_app.h"
+
+namespace Cli {
+
+// `fuzz [cases [seed [max_size [large_max_size]]]]`: differential solver
+// fuzzing, exit code 1 when any case fails.
+void RegisterFuzzCommand(CliApp& app);
+
+}  // namespace Cli
+
+#endif  // FUZZ_COMMAND_H
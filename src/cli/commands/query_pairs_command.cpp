@@ -0,0 +1,120 @@
+#include "cli/commands/query_pairs_command.h"
+
+#include <array>
+#include <exception>
+#include <sstream>
+
+namespace Cli {
+
+namespace {
+
+constexpr size_t kQueryPairFields = 4;
+
+// Accepts "startY,startX,endY,endX" groups separated by ';'.
+auto ParseQueryPairs(const std::vector<std::string>& args,
+                     std::vector<Config::QueryPair>& out, std::string& error)
+    -> bool {
+  for (const auto& arg : args) {
+    std::stringstream pairs_stream(arg);
+    std::string group;
+    while (std::getline(pairs_stream, group, ';')) {
+      if (group.find_first_not_of(" \t") == std::string::npos) {
+        continue;
+      }
+      std::stringstream fields_stream(group);
+      std::string field;
+      std::array<int, kQueryPairFields> values{};
+      size_t count = 0;
+      while (std::getline(fields_stream, field, ',')) {
+        if (count >= kQueryPairFields) {
+          error = "Too many coordinates in query pair: " + group;
+          return false;
+        }
+        try {
+          values[count++] = std::stoi(field);
+        } catch (const std::exception&) {
+          error = "Invalid coordinate '" + field + "' in query pair: " + group;
+          return false;
+        }
+      }
+      if (count != kQueryPairFields) {
+        error = "Query pair needs startY,startX,endY,endX: " + group;
+        return false;
+      }
+      out.push_back({.start_node = {values[0], values[1]},
+                     .end_node = {values[2], values[3]}});
+    }
+  }
+  return true;
+}
+
+void PrintQueryPairs(const std::vector<Config::QueryPair>& pairs,
+                     std::ostream& out) {
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    out << pairs[i].start_node.first << "," << pairs[i].start_node.second
+        << "," << pairs[i].end_node.first << "," << pairs[i].end_node.second;
+    if (i < pairs.size() - 1) {
+      out << ";";
+    }
+  }
+  out << "\n";
+}
+
+auto HandleQueryPairs(const std::vector<std::string>& args,
+                      CommandContext& ctx) -> int {
+  if (args.empty()) {
+    ctx.out << "QueryPairs (" << ctx.config.maze.query_pairs.size() << "): ";
+    PrintQueryPairs(ctx.config.maze.query_pairs, ctx.out);
+    ctx.out << "BatchThreads: " << ctx.config.maze.batch_threads << "\n";
+    return 0;
+  }
+  return ApplyQueryPairs(args, ctx);
+}
+
+}  // namespace
+
+auto ApplyQueryPairs(const std::vector<std::string>& args,
+                     CommandContext& ctx) -> int {
+  std::vector<Config::QueryPair> pairs;
+  std::string error;
+  if (!ParseQueryPairs(args, pairs, error)) {
+    ctx.err << error << "\n";
+    return 1;
+  }
+  if (pairs.empty()) {
+    ctx.err << "No query pairs provided.\n";
+    return 1;
+  }
+
+  ctx.config.maze.query_pairs = std::move(pairs);
+  ctx.out << "QueryPairs set to: ";
+  PrintQueryPairs(ctx.config.maze.query_pairs, ctx.out);
+  return 0;
+}
+
+auto ApplyBatchThreads(const std::string& value, CommandContext& ctx) -> int {
+  try {
+    const int kThreads = std::stoi(value);
+    if (kThreads < 0) {
+      ctx.err << "BatchThreads must be >= 0 (0 = all hardware threads).\n";
+      return 1;
+    }
+    ctx.config.maze.batch_threads = kThreads;
+  } catch (const std::exception&) {
+    ctx.err << "Invalid BatchThreads value: " << value << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+void RegisterQueryPairsCommand(CliApp& app) {
+  Command command;
+  command.name = "queries";
+  command.description =
+      "Show or override QueryPairs (startY,startX,endY,endX;...)";
+  command.handler = HandleQueryPairs;
+  command.exit_after = true;
+  app.register_command(std::move(command));
+}
+
+}  // namespace Cli
@@ -0,0 +1,14 @@
+#ifndef QUERY_PAIRS_COMMAND_H
+#define QUERY_PAIRS_COMMAND_H
+
+#include "cli/framework/cli_app.h"
+
+namespace Cli {
+
+void RegisterQueryPairsCommand(CliApp& app);
+int ApplyQueryPairs(const std::vector<std::string>& args, CommandContext& ctx);
+int ApplyBatchThreads(const std::string& value, CommandContext& ctx);
+
+}  // namespace Cli
+
+#endif  // QUERY_PAIRS_COMMAND_H
@@ -4,7 +4,9 @@
 
 #include "application/services/maze_generation.h"
 #include "application/services/maze_solver.h"
+#include "cli/commands/distance_field_command.h"
 #include "cli/commands/generation_algorithms_command.h"
+#include "cli/commands/query_pairs_command.h"
 #include "cli/commands/search_algorithms_command.h"
 #include "common/version.hpp"
 
@@ -32,6 +34,18 @@ auto IsSearchAlgorithmsToken(const std::string& token) -> bool {
   return token == "--search-algorithms";
 }
 
+auto IsQueriesToken(const std::string& token) -> bool {
+  return token == "--queries";
+}
+
+auto IsBatchThreadsToken(const std::string& token) -> bool {
+  return token == "--batch-threads";
+}
+
+auto IsDistanceFieldToken(const std::string& token) -> bool {
+  return token == "--distance-field";
+}
+
 struct OptionOutcome {
   bool consumed = false;
   bool handled = false;
@@ -115,6 +129,32 @@ auto ConsumeOptionValue(const std::string& token,
     return outcome;
   }
 
+  if (IsQueriesToken(token) || IsBatchThreadsToken(token) ||
+      IsDistanceFieldToken(token)) {
+    outcome.consumed = true;
+    if (index + 1 >= argc) {
+      ctx.err << "Missing value for " << token << "\n";
+      outcome.handled = true;
+      outcome.exit_code = 1;
+      return outcome;
+    }
+    const std::string kValue = argv[++index];
+    int code = 0;
+    if (IsQueriesToken(token)) {
+      code = ApplyQueryPairs({kValue}, ctx);
+    } else if (IsBatchThreadsToken(token)) {
+      code = ApplyBatchThreads(kValue, ctx);
+    } else {
+      code = ApplyDistanceField(kValue, ctx);
+    }
+    if (code != 0) {
+      outcome.handled = true;
+      outcome.exit_code = code;
+      return outcome;
+    }
+    return outcome;
+  }
+
   return outcome;
 }
 
@@ -155,6 +195,11 @@ void CliApp::print_help(std::ostream& out) const {
   out << "  --search-algorithms <list>\n";
   out << "                      Override SearchAlgorithms "
          "(comma-separated)\n";
+  out << "  --queries <list>     Override QueryPairs "
+         "(startY,startX,endY,endX;...)\n";
+  out << "  --batch-threads <n>  Worker threads for QueryPairs (0 = all)\n";
+  out << "  --distance-field <n> Compute the start node's distance field "
+         "with n threads (0 = all)\n";
   out << "  -o, --output <dir>   Set output directory\n";
   out << "  -h, --help           Show this help\n";
 
@@ -20,14 +20,69 @@ struct SearchAlgorithmInfo {
   std::string name;
 };
 
+struct QueryPair {
+  std::pair<int, int> start_node;
+  std::pair<int, int> end_node;
+};
+
 struct MazeConfig {
   int width = 10;
   int height = 10;
   int unit_pixels = 15;
   std::pair<int, int> start_node = {0, 0};
   std::pair<int, int> end_node = {0, 0};
+  // Replace start/end per maze with the ends of its longest shortest path.
+  bool hardest_endpoints = false;
   std::vector<AlgorithmInfo> generation_algorithms;
   std::vector<SearchAlgorithmInfo> search_algorithms;
+  std::vector<QueryPair> query_pairs;
+  // Extra exits; when set, each maze also reports the nearest one.
+  std::vector<std::pair<int, int>> exit_nodes;
+  int batch_threads = 0;
+  bool distance_field = false;
+  int distance_field_threads = 0;
+  // Distances between all points of interest: start, end, exits and the
+  // query pair endpoints.
+  bool distance_matrix = false;
+  // 0 keeps every step at cost 1; otherwise cells get random weights in
+  // [1, terrain_cost_max] for the weighted searches.
+  int terrain_cost_max = 0;
+  // Random interior walls toggled before the incremental re-plan; 0 skips it.
+  int replan_wall_edits = 0;
+  // Export each maze to a packed file and walk it memory-mapped.
+  bool out_of_core_walk = false;
+  // Random start cells routed to the end node through one flow field, saved
+  // and reloaded from disk first; 0 skips it.
+  int flow_field_agents = 0;
+  // Search budgets, 0 means unlimited: expanded cells per query, wall-clock
+  // time per Solve() call or batch, and frames per recorded search.
+  int max_expanded_nodes = 0;
+  int solve_time_limit_ms = 0;
+  int max_frames = 0;
+  // BFS, Dijkstra and A* queue only junctions and dead ends, walking the
+  // corridors between them inline.
+  bool skip_corridors = false;
+  // A* landmarks for the ALT heuristic; 0 keeps plain Manhattan.
+  int landmark_count = 0;
+  // Cluster edge length of the Hierarchical (HPA*) solver; 0 = default.
+  int cluster_size = 0;
+  // Workers of the Parallel A* (HDA*) solver; 0 uses all hardware threads.
+  int search_threads = 0;
+  // Seal dead ends before every search, so solvers only see cells that can
+  // lie on the path.
+  bool dead_end_prefilter = false;
+  // Keep solver and batch paths run-length encoded (start cell plus
+  // direction runs) instead of one entry per cell.
+  bool compact_paths = false;
+  // Solve() results kept in memory, least recently used evicted first, keyed
+  // by maze walls, endpoints, solver and options; 0 disables the cache.
+  int solve_cache_entries = 0;
+  // Memory budget of those results, which recorded frames dominate;
+  // 0 bounds them by count only.
+  int solve_cache_max_mib = 256;
+  // Also persists cached results here across runs; empty keeps them in
+  // memory only.
+  std::string solve_cache_dir;
 };
 
 struct ColorConfig {
@@ -0,0 +1,66 @@
+#include "domain/maze_adjacency.h"
+
+#include <bit>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+// Direction bits, same order as MazeCell::walls.
+constexpr int kTop = 0;
+constexpr int kRight = 1;
+constexpr int kBottom = 2;
+constexpr int kLeft = 3;
+
+}  // namespace
+
+MazeAdjacency::MazeAdjacency(const MazeDomain::MazeGrid& maze_grid) {
+  height_ = static_cast<int>(maze_grid.size());
+  width_ = height_ > 0 ? static_cast<int>(maze_grid[0].size()) : 0;
+  if (width_ <= 0) {
+    height_ = 0;
+    width_ = 0;
+    return;
+  }
+
+  for (int dir = 0; dir < kDirectionCount; ++dir) {
+    offsets_[dir] = (kRowDelta[dir] * width_) + kColDelta[dir];
+  }
+
+  // Border sides are folded in once per cell, so a wall missing on the
+  // outer edge never yields an out-of-grid neighbour.
+  masks_.resize(static_cast<size_t>(height_) * static_cast<size_t>(width_));
+  constexpr unsigned kAllOpen = (1U << kDirectionCount) - 1;
+  for (int row = 0; row < height_; ++row) {
+    unsigned row_mask = kAllOpen;
+    if (row == 0) {
+      row_mask &= ~(1U << kTop);
+    }
+    if (row == height_ - 1) {
+      row_mask &= ~(1U << kBottom);
+    }
+    const auto& cells = maze_grid[row];
+    std::uint8_t* masks = masks_.data() + (static_cast<size_t>(row) * width_);
+    for (int col = 0; col < width_; ++col) {
+      const auto& walls = cells[col].walls;
+      unsigned mask = (walls[kTop] ? 0U : 1U << kTop) |
+                      (walls[kRight] ? 0U : 1U << kRight) |
+                      (walls[kBottom] ? 0U : 1U << kBottom) |
+                      (walls[kLeft] ? 0U : 1U << kLeft);
+      mask &= row_mask;
+      if (col == 0) {
+        mask &= ~(1U << kLeft);
+      }
+      if (col == width_ - 1) {
+        mask &= ~(1U << kRight);
+      }
+      masks[col] = static_cast<std::uint8_t>(mask);
+    }
+  }
+}
+
+auto MazeAdjacency::Degree(int index) const -> int {
+  return std::popcount(masks_[index]);
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,96 @@
+#ifndef MAZE_DOMAIN_MAZE_ADJACENCY_H
+#define MAZE_DOMAIN_MAZE_ADJACENCY_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Flat, read-only view of a maze's open passages. Cells are addressed by
+// row-major index; bit `dir` of a cell's mask is set when MazeCell::walls[dir]
+// is open and the neighbour in that direction lies inside the grid.
+class MazeAdjacency {
+ public:
+  static constexpr int kDirectionCount = MazeDomain::kWallCount;
+  static constexpr std::array<int, kDirectionCount> kRowDelta = {-1, 0, 1, 0};
+  static constexpr std::array<int, kDirectionCount> kColDelta = {0, 1, 0, -1};
+
+  explicit MazeAdjacency(const MazeDomain::MazeGrid& maze_grid);
+
+  auto Height() const -> int { return height_; }
+  auto Width() const -> int { return width_; }
+  auto CellCount() const -> int { return height_ * width_; }
+
+  auto IndexOf(GridPosition pos) const -> int {
+    return (pos.first * width_) + pos.second;
+  }
+  auto PositionOf(int index) const -> GridPosition {
+    return {index / width_, index % width_};
+  }
+
+  auto OpenMask(int index) const -> std::uint8_t { return masks_[index]; }
+  auto IsOpen(int index, int dir) const -> bool {
+    return (masks_[index] & (1U << dir)) != 0;
+  }
+  auto Degree(int index) const -> int;
+  auto Neighbor(int index, int dir) const -> int {
+    return index + offsets_[dir];
+  }
+
+  auto Offset(int dir) const -> int { return offsets_[dir]; }
+
+  static constexpr auto Opposite(int dir) -> int {
+    return (dir + (kDirectionCount / 2)) % kDirectionCount;
+  }
+
+ private:
+  int height_ = 0;
+  int width_ = 0;
+  std::array<int, kDirectionCount> offsets_{};
+  std::vector<std::uint8_t> masks_;
+};
+
+// Flat-index offsets of the open neighbours for every 4-bit open mask, in a
+// fixed direction order. Expanding a cell walks its mask's entry: no bounds
+// checks and no per-direction wall tests.
+class NeighborTable {
+ public:
+  static constexpr int kMaskCount = 1 << MazeAdjacency::kDirectionCount;
+
+  struct Entry {
+    int count = 0;
+    std::array<int, MazeAdjacency::kDirectionCount> offsets{};
+
+    auto begin() const -> const int* { return offsets.data(); }
+    auto end() const -> const int* { return offsets.data() + count; }
+  };
+
+  NeighborTable(const MazeAdjacency& adjacency,
+                const std::array<int, MazeAdjacency::kDirectionCount>& order)
+      : adjacency_(adjacency) {
+    for (int mask = 0; mask < kMaskCount; ++mask) {
+      Entry& entry = entries_[mask];
+      for (const int kDir : order) {
+        if ((mask & (1 << kDir)) != 0) {
+          entry.offsets[entry.count++] = adjacency.Offset(kDir);
+        }
+      }
+    }
+  }
+
+  auto Of(int index) const -> const Entry& {
+    return entries_[adjacency_.OpenMask(index)];
+  }
+
+ private:
+  const MazeAdjacency& adjacency_;
+  std::array<Entry, kMaskCount> entries_{};
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_ADJACENCY_H
@@ -0,0 +1,258 @@
+#include "domain/maze_batch_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_cluster_graph.h"
+#include "domain/maze_junction_graph.h"
+#include "domain/maze_landmarks.h"
+#include "domain/maze_path_index.h"
+#include "domain/maze_search_budget.h"
+#include "domain/maze_search_kernel.h"
+#include "domain/maze_search_policies.h"
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr size_t kQueriesPerClaim = 16;
+
+// One query on the worker's reusable state; the answer is read back from its
+// parent links. `policy` carries heuristic data (the landmark table).
+template <typename Policy>
+auto RunQuery(const MazeAdjacency& adjacency, const QueryPair& query,
+              SearchBudget& budget, detail::SearchState& state,
+              const Policy& policy = {}) -> bool {
+  // Only the recorder's no-op hooks run.
+  SearchResult unused_result;
+  SearchStats unused_stats;
+  detail::NullRecorder recorder(adjacency, budget, unused_result);
+  state.Begin(adjacency.CellCount());
+  return detail::RunSearch<Policy>(
+      adjacency, {.start = query.first, .end = query.second}, budget,
+      recorder, state, unused_stats, policy);
+}
+
+// Runs the corridor-skipping variant of Policy when options ask for it.
+template <typename Policy>
+auto RunQueryWithCorridors(const MazeAdjacency& adjacency,
+                           const QueryPair& query, const SolveOptions& options,
+                           SearchBudget& budget, detail::SearchState& state,
+                           const Policy& policy = {}) -> bool {
+  if (options.skip_corridors) {
+    return RunQuery(adjacency, query, budget, state,
+                    detail::CorridorSkipping<Policy>{policy});
+  }
+  return RunQuery(adjacency, query, budget, state, policy);
+}
+
+struct SharedIndexes {
+  std::optional<JunctionGraph> junction_graph;
+  std::optional<ClusterGraph> cluster_graph;
+  std::optional<TreePathIndex> tree_index;
+  std::optional<LandmarkTable> landmarks;
+};
+
+struct WorkerState {
+  detail::SearchState search_state;
+  JunctionGraph::Workspace junction_workspace;
+  ClusterGraph::Workspace cluster_workspace;
+};
+
+auto AnswerQuery(const MazeAdjacency& adjacency, const SharedIndexes& indexes,
+                 SolverAlgorithmType algorithm_type, const QueryPair& query,
+                 const SolveOptions& options, WorkerState& state)
+    -> BatchQueryResult {
+  BatchQueryResult result;
+  const auto kInside = [&adjacency](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < adjacency.Height() &&
+           pos.second >= 0 && pos.second < adjacency.Width();
+  };
+  if (!kInside(query.first) || !kInside(query.second)) {
+    return result;
+  }
+  if (query.first == query.second) {
+    result.found_ = true;
+    result.path_.push_back(query.first);
+    return result;
+  }
+
+  SearchBudget budget(options);
+  if (indexes.tree_index.has_value()) {
+    // An O(path) lookup with no loop to charge; only the deadline and stop
+    // token can refuse it.
+    if (budget.Poll()) {
+      result.found_ = true;
+      result.path_ = indexes.tree_index->Path(query.first, query.second);
+    }
+    result.termination_ = budget.Termination();
+    return result;
+  }
+  if (indexes.cluster_graph.has_value()) {
+    HierarchicalPath hierarchical_path = indexes.cluster_graph->FindPath(
+        query.first, query.second, state.cluster_workspace, &budget);
+    result.found_ = hierarchical_path.found_;
+    result.path_ = std::move(hierarchical_path.path_);
+    result.termination_ = budget.Termination();
+    result.expanded_ = budget.Expanded();
+    return result;
+  }
+  if (indexes.junction_graph.has_value()) {
+    JunctionPath junction_path = indexes.junction_graph->FindPath(
+        query.first, query.second, state.junction_workspace, &budget);
+    result.found_ = junction_path.found_;
+    result.path_ = std::move(junction_path.path_);
+    result.termination_ = budget.Termination();
+    result.expanded_ = budget.Expanded();
+    return result;
+  }
+
+  detail::SearchState& search_state = state.search_state;
+  switch (algorithm_type) {
+    case SolverAlgorithmType::DFS:
+      result.found_ = RunQuery<detail::DepthFirstPolicy>(adjacency, query,
+                                                         budget, search_state);
+      break;
+    case SolverAlgorithmType::ASTAR:
+      if (indexes.landmarks.has_value()) {
+        result.found_ = RunQueryWithCorridors(
+            adjacency, query, options, budget, search_state,
+            detail::LandmarkAStarPolicy{
+                .landmarks = &*indexes.landmarks,
+                .target = indexes.landmarks->DistancesTo(
+                    adjacency.IndexOf(query.second))});
+      } else {
+        result.found_ = RunQueryWithCorridors<detail::AStarPolicy>(
+            adjacency, query, options, budget, search_state);
+      }
+      break;
+    case SolverAlgorithmType::DIJKSTRA:
+      result.found_ = RunQueryWithCorridors<detail::DijkstraPolicy>(
+          adjacency, query, options, budget, search_state);
+      break;
+    case SolverAlgorithmType::GREEDY_BEST_FIRST:
+      result.found_ = RunQuery<detail::GreedyBestFirstPolicy>(
+          adjacency, query, budget, search_state);
+      break;
+    default:
+      // BFS; SolveBatch() maps the other types first. Skipping corridors
+      // needs the distance-ordered search, as in Solve().
+      result.found_ =
+          options.skip_corridors
+              ? RunQuery<detail::CorridorSkipping<detail::DijkstraPolicy>>(
+                    adjacency, query, budget, search_state)
+              : RunQuery<detail::BreadthFirstPolicy>(adjacency, query,
+                                                     budget, search_state);
+      break;
+  }
+  const int kStart = adjacency.IndexOf(query.first);
+  const int kEnd = adjacency.IndexOf(query.second);
+  if (result.found_ && options.compact_path) {
+    result.compact_path_ = CompactPath::FromParents(
+        adjacency.Width(), kStart, kEnd,
+        [&search_state](int cell) -> int {
+          return search_state.parents[cell];
+        });
+  } else if (result.found_) {
+    result.path_ = detail::ExtractCellPath(adjacency, search_state.parents,
+                                           kStart, kEnd);
+  }
+  result.termination_ = budget.Termination();
+  result.expanded_ = budget.Expanded();
+  return result;
+}
+
+}  // namespace
+
+auto BatchSolverFor(SolverAlgorithmType algorithm_type)
+    -> std::optional<SolverAlgorithmType> {
+  switch (algorithm_type) {
+    case SolverAlgorithmType::PARALLEL_ASTAR:
+      // The queries already spread over the workers; each runs plain A*.
+      return SolverAlgorithmType::ASTAR;
+    case SolverAlgorithmType::BITBOARD_BFS:
+    case SolverAlgorithmType::DEAD_END_FILLING:
+      return SolverAlgorithmType::BFS;
+    case SolverAlgorithmType::WALL_FOLLOWER:
+    case SolverAlgorithmType::TREMAUX:
+      return std::nullopt;
+    default:
+      return algorithm_type;
+  }
+}
+
+auto SolveBatch(const MazeDomain::MazeGrid& maze_grid,
+                std::span<const QueryPair> queries,
+                SolverAlgorithmType algorithm_type, unsigned threads,
+                const SolveOptions& options) -> std::vector<BatchQueryResult> {
+  std::vector<BatchQueryResult> results(queries.size());
+  const auto kBatchSolver = BatchSolverFor(algorithm_type);
+  const MazeAdjacency kAdjacency(maze_grid);
+  if (queries.empty() || !kBatchSolver.has_value() ||
+      kAdjacency.CellCount() == 0) {
+    return results;
+  }
+
+  algorithm_type = *kBatchSolver;
+  SharedIndexes indexes;
+  if (algorithm_type == SolverAlgorithmType::JUNCTION_GRAPH) {
+    indexes.junction_graph.emplace(maze_grid);
+  } else if (algorithm_type == SolverAlgorithmType::HIERARCHICAL) {
+    indexes.cluster_graph.emplace(maze_grid,
+                                  options.cluster_size > 0
+                                      ? options.cluster_size
+                                      : ClusterGraph::kDefaultClusterSize,
+                                  threads);
+  } else if (algorithm_type == SolverAlgorithmType::TREE_LCA) {
+    // Falls back to the BFS kernel when the maze is not a spanning tree.
+    indexes.tree_index = TreePathIndex::Build(maze_grid);
+  } else if (algorithm_type == SolverAlgorithmType::ASTAR &&
+             options.landmark_count > 0) {
+    // Built once here and shared read-only by every worker.
+    indexes.landmarks.emplace(kAdjacency, options.landmark_count);
+  }
+
+  size_t worker_count =
+      threads == 0 ? std::max(1U, std::thread::hardware_concurrency())
+                   : threads;
+  worker_count = std::min(
+      worker_count, (queries.size() + kQueriesPerClaim - 1) / kQueriesPerClaim);
+
+  std::atomic<size_t> next_query{0};
+  const auto kWorker = [&]() -> void {
+    WorkerState state;
+    while (true) {
+      const size_t kBegin =
+          next_query.fetch_add(kQueriesPerClaim, std::memory_order_relaxed);
+      if (kBegin >= queries.size()) {
+        return;
+      }
+      const size_t kEnd = std::min(kBegin + kQueriesPerClaim, queries.size());
+      for (size_t index = kBegin; index < kEnd; ++index) {
+        BatchQueryResult& result = results[index];
+        result = AnswerQuery(kAdjacency, indexes, algorithm_type,
+                             queries[index], options, state);
+        // Index lookups and trivial queries come back as cell lists.
+        if (options.compact_path && !result.path_.empty()) {
+          result.compact_path_ = CompactPath::FromPath(result.path_);
+          result.path_ = {};
+        }
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(worker_count - 1);
+    for (size_t worker = 1; worker < worker_count; ++worker) {
+      pool.emplace_back(kWorker);
+    }
+    kWorker();
+  }
+  return results;
+}
+
+}  // namespace MazeSolverDomain
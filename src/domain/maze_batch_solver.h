@@ -0,0 +1,62 @@
+#ifndef MAZE_DOMAIN_MAZE_BATCH_SOLVER_H
+#define MAZE_DOMAIN_MAZE_BATCH_SOLVER_H
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+using QueryPair = std::pair<GridPosition, GridPosition>;
+
+struct BatchQueryResult {
+  bool found_ = false;
+  std::vector<GridPosition> path_;
+  SearchTermination termination_ = SearchTermination::COMPLETED;
+  // Cells the search expanded; abstract nodes plus the cells their cluster
+  // searches reached for HIERARCHICAL, closed nodes for JUNCTION_GRAPH, and
+  // zero for TREE_LCA lookups.
+  size_t expanded_ = 0;
+  // Filled instead of path_ under SolveOptions::compact_path.
+  CompactPath compact_path_;
+
+  auto PathCells() const -> size_t {
+    return compact_path_.Empty() ? path_.size() : compact_path_.CellCount();
+  }
+};
+
+// The solver SolveBatch() runs for `algorithm_type`: PARALLEL_ASTAR queries
+// run as ASTAR, one per worker, and BITBOARD_BFS and DEAD_END_FILLING as BFS,
+// which reports paths of the same length. WALL_FOLLOWER and TREMAUX have no
+// batch form and give std::nullopt.
+std::optional<SolverAlgorithmType> BatchSolverFor(
+    SolverAlgorithmType algorithm_type);
+
+// Answers many (start, end) queries against one maze. The maze is flattened
+// once and shared read-only; every worker runs Solve()'s search kernel and
+// policies on one reusable SearchState, so a query returns the path Solve()
+// reports (queue BFS for BFS) without per-query grid allocation or frame
+// recording. Results come back in input order. `threads == 0` uses std::thread::hardware_concurrency().
+// options.max_expanded_nodes applies to each query; the deadline and stop
+// token cut the whole batch short, and queries they stop report why (TREE_LCA
+// lookups only check them before each query). ASTAR with
+// options.landmark_count builds one LandmarkTable for the whole batch,
+// HIERARCHICAL one ClusterGraph (built on `threads` workers as well). Types
+// are first mapped through BatchSolverFor(); one without a batch form leaves
+// every query not found. options.skip_corridors applies as in Solve(), and
+// options.compact_path encodes the search paths straight from the parent
+// links.
+std::vector<BatchQueryResult> SolveBatch(const MazeDomain::MazeGrid& maze_grid,
+                                         std::span<const QueryPair> queries,
+                                         SolverAlgorithmType algorithm_type,
+                                         unsigned threads,
+                                         const SolveOptions& options = {});
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_BATCH_SOLVER_H
@@ -0,0 +1,78 @@
+#ifndef MAZE_DOMAIN_MAZE_BUCKET_QUEUE_H
+#define MAZE_DOMAIN_MAZE_BUCKET_QUEUE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace MazeSolverDomain {
+
+// Circular bucket queue (Dial's algorithm) for monotone integer keys: every
+// pushed key must be at least the last popped key and at most max_key_step
+// above it. That holds for Dijkstra with edge costs up to max_key_step and
+// for A* with a consistent heuristic (unit mazes + Manhattan: the f-score
+// grows by 0 or 2 per step). Push and Pop are O(1) amortised; the pop cursor
+// only moves forward and wraps over max_key_step + 1 buckets. Entries with
+// equal keys come out newest first. Buckets keep their capacity across
+// Clear(), so a reused queue stops allocating once it has seen its widest
+// frontier.
+template <typename Value>
+class BucketQueue {
+ public:
+  explicit BucketQueue(int max_key_step)
+      : buckets_(std::bit_ceil(static_cast<size_t>(max_key_step) + 1)),
+        mask_(buckets_.size() - 1) {}
+
+  auto Empty() const -> bool { return size_ == 0; }
+  auto Size() const -> size_t { return size_; }
+
+  void Push(int key, const Value& value) {
+    cursor_ = std::min(cursor_, key);
+    buckets_[static_cast<size_t>(key) & mask_].push_back(value);
+    ++size_;
+  }
+
+  // Smallest key in the queue. Requires !Empty().
+  auto MinKey() -> int {
+    SkipEmptyBuckets();
+    return cursor_;
+  }
+
+  // Removes and returns an entry with the smallest key. Requires !Empty().
+  auto Pop() -> Value {
+    SkipEmptyBuckets();
+    auto& bucket = buckets_[static_cast<size_t>(cursor_) & mask_];
+    const Value kValue = bucket.back();
+    bucket.pop_back();
+    --size_;
+    return kValue;
+  }
+
+  void Clear() {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    size_ = 0;
+    cursor_ = kNoCursor;
+  }
+
+ private:
+  static constexpr int kNoCursor = std::numeric_limits<int>::max();
+
+  void SkipEmptyBuckets() {
+    while (buckets_[static_cast<size_t>(cursor_) & mask_].empty()) {
+      ++cursor_;
+    }
+  }
+
+  std::vector<std::vector<Value>> buckets_;
+  size_t mask_;
+  size_t size_ = 0;
+  int cursor_ = kNoCursor;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_BUCKET_QUEUE_H
@@ -0,0 +1,47 @@
+#include "domain/maze_cell_weights.h"
+
+#include <algorithm>
+#include <random>
+
+namespace MazeDomain {
+
+namespace {
+
+constexpr int kMinWeight = 1;
+constexpr int kMaxWeight = 255;
+
+}  // namespace
+
+CellWeights::CellWeights(int height, int width, std::uint8_t fill)
+    : height_(std::max(height, 0)), width_(std::max(width, 0)) {
+  weights_.assign(static_cast<size_t>(height_) * static_cast<size_t>(width_),
+                  std::max<std::uint8_t>(fill, kMinWeight));
+}
+
+void CellWeights::set(std::pair<int, int> pos, std::uint8_t weight) {
+  weights_[index_of(pos)] = std::max<std::uint8_t>(weight, kMinWeight);
+}
+
+auto CellWeights::min_weight() const -> std::uint8_t {
+  if (weights_.empty()) {
+    return kMinWeight;
+  }
+  return *std::ranges::min_element(weights_);
+}
+
+auto generate_cell_weights(int height, int width, int max_weight)
+    -> CellWeights {
+  CellWeights weights(height, width);
+  const int kMaxWeightClamped = std::clamp(max_weight, kMinWeight, kMaxWeight);
+  std::random_device random_device;
+  std::mt19937 engine(random_device());
+  std::uniform_int_distribution<int> weight_dist(kMinWeight, kMaxWeightClamped);
+  for (int row = 0; row < weights.height(); ++row) {
+    for (int col = 0; col < weights.width(); ++col) {
+      weights.set({row, col}, static_cast<std::uint8_t>(weight_dist(engine)));
+    }
+  }
+  return weights;
+}
+
+}  // namespace MazeDomain
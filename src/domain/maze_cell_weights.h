@@ -0,0 +1,48 @@
+#ifndef MAZE_DOMAIN_MAZE_CELL_WEIGHTS_H
+#define MAZE_DOMAIN_MAZE_CELL_WEIGHTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace MazeDomain {
+
+// Optional terrain costs kept next to a MazeGrid rather than inside MazeCell,
+// so unweighted mazes pay nothing for them. One byte per cell, row-major;
+// stepping into a cell costs its weight (1..255).
+class CellWeights {
+ public:
+  CellWeights() = default;
+  CellWeights(int height, int width, std::uint8_t fill = 1);
+
+  auto height() const -> int { return height_; }
+  auto width() const -> int { return width_; }
+  auto empty() const -> bool { return weights_.empty(); }
+
+  auto at(std::pair<int, int> pos) const -> std::uint8_t {
+    return weights_[index_of(pos)];
+  }
+  void set(std::pair<int, int> pos, std::uint8_t weight);
+  // Weight of the cell at a row-major index.
+  auto at_index(size_t index) const -> std::uint8_t { return weights_[index]; }
+  std::uint8_t min_weight() const;
+
+ private:
+  auto index_of(std::pair<int, int> pos) const -> size_t {
+    return (static_cast<size_t>(pos.first) * static_cast<size_t>(width_)) +
+           static_cast<size_t>(pos.second);
+  }
+
+  int height_ = 0;
+  int width_ = 0;
+  std::vector<std::uint8_t> weights_;
+};
+
+// Uniformly random weights in [1, max_weight]; max_weight is clamped to
+// [1, 255].
+CellWeights generate_cell_weights(int height, int width, int max_weight);
+
+}  // namespace MazeDomain
+
+#endif  // MAZE_DOMAIN_MAZE_CELL_WEIGHTS_H
@@ -0,0 +1,533 @@
+#include "domain/maze_cluster_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+
+#include "domain/maze_adjacency.h"
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr int kNoCell = -1;
+constexpr int kGoalNode = -2;
+constexpr int kUnreachable = std::numeric_limits<int>::max();
+constexpr size_t kClustersPerClaim = 8;
+
+constexpr auto HeapAfter = [](const auto& left, const auto& right) -> bool {
+  if (left.f_score != right.f_score) {
+    return left.f_score > right.f_score;
+  }
+  return left.g_score < right.g_score;
+};
+
+}  // namespace
+
+void ClusterGraph::LocalSearch::Reset(int cell_count) {
+  const auto kCellCount = static_cast<size_t>(cell_count);
+  if (stamp_.size() < kCellCount) {
+    stamp_.assign(kCellCount, 0);
+    distance_.resize(kCellCount);
+    parent_.resize(kCellCount);
+    epoch_ = 0;
+  }
+  if (++epoch_ == 0) {
+    std::ranges::fill(stamp_, 0);
+    epoch_ = 1;
+  }
+  queue_.clear();
+}
+
+void ClusterGraph::LocalSearch::Reach(int local, int distance, int parent) {
+  stamp_[local] = epoch_;
+  distance_[local] = distance;
+  parent_[local] = parent;
+  queue_.push_back(local);
+}
+
+ClusterGraph::ClusterGraph(const MazeDomain::MazeGrid& maze_grid,
+                           int cluster_size, unsigned threads)
+    : cluster_size_(std::max(cluster_size, 1)) {
+  const MazeAdjacency kAdjacency(maze_grid);
+  height_ = kAdjacency.Height();
+  width_ = kAdjacency.Width();
+  for (int dir = 0; dir < MazeDomain::kWallCount; ++dir) {
+    offsets_[dir] = kAdjacency.Offset(dir);
+  }
+  masks_.resize(static_cast<size_t>(kAdjacency.CellCount()));
+  for (int cell = 0; cell < kAdjacency.CellCount(); ++cell) {
+    masks_[cell] = kAdjacency.OpenMask(cell);
+  }
+
+  cluster_cols_ = (width_ + cluster_size_ - 1) / cluster_size_;
+  const int kClusterRows = (height_ + cluster_size_ - 1) / cluster_size_;
+  clusters_.resize(static_cast<size_t>(kClusterRows) * cluster_cols_);
+  std::vector<int> all(clusters_.size());
+  for (int cluster = 0; cluster < ClusterCount(); ++cluster) {
+    all[cluster] = cluster;
+  }
+  BuildClusters(all, threads);
+}
+
+auto ClusterGraph::EdgeCount() const -> size_t {
+  size_t count = 0;
+  for (const auto& cluster : clusters_) {
+    count += cluster.edges.size();
+  }
+  return count;
+}
+
+auto ClusterGraph::ClusterOf(int cell) const -> int {
+  const GridPosition kPos = PositionOf(cell);
+  return ((kPos.first / cluster_size_) * cluster_cols_) +
+         (kPos.second / cluster_size_);
+}
+
+auto ClusterGraph::BoundsOf(int cluster) const -> Bounds {
+  const int kRowBegin = (cluster / cluster_cols_) * cluster_size_;
+  const int kColBegin = (cluster % cluster_cols_) * cluster_size_;
+  return {.row_begin = kRowBegin,
+          .row_end = std::min(kRowBegin + cluster_size_, height_),
+          .col_begin = kColBegin,
+          .col_end = std::min(kColBegin + cluster_size_, width_)};
+}
+
+auto ClusterGraph::LocalOf(const Bounds& bounds, int cell) const -> int {
+  const GridPosition kPos = PositionOf(cell);
+  return ((kPos.first - bounds.row_begin) * bounds.Width()) +
+         (kPos.second - bounds.col_begin);
+}
+
+auto ClusterGraph::CellOf(const Bounds& bounds, int local) const -> int {
+  return IndexOf({bounds.row_begin + (local / bounds.Width()),
+                  bounds.col_begin + (local % bounds.Width())});
+}
+
+auto ClusterGraph::Crosses(int cell, int dir, const Bounds& bounds) const
+    -> bool {
+  if ((masks_[cell] & (1U << dir)) == 0) {
+    return false;
+  }
+  const GridPosition kPos = PositionOf(cell);
+  const int kRow = kPos.first + MazeAdjacency::kRowDelta[dir];
+  const int kCol = kPos.second + MazeAdjacency::kColDelta[dir];
+  return kRow < bounds.row_begin || kRow >= bounds.row_end ||
+         kCol < bounds.col_begin || kCol >= bounds.col_end;
+}
+
+auto ClusterGraph::NodeOf(int cluster, int cell) const -> int {
+  const auto& entrances = clusters_[cluster].entrances;
+  return entrance_base_[cluster] +
+         static_cast<int>(std::ranges::lower_bound(entrances, cell) -
+                          entrances.begin());
+}
+
+auto ClusterGraph::CellOfNode(int node) const -> int {
+  const auto kCluster = static_cast<size_t>(
+      std::ranges::upper_bound(entrance_base_, node) - entrance_base_.begin() -
+      1);
+  return clusters_[kCluster].entrances[node - entrance_base_[kCluster]];
+}
+
+void ClusterGraph::BuildClusters(std::span<const int> clusters,
+                                 unsigned threads) {
+  size_t worker_count =
+      threads == 0 ? std::max(1U, std::thread::hardware_concurrency())
+                   : threads;
+  worker_count = std::min(
+      worker_count,
+      (clusters.size() + kClustersPerClaim - 1) / kClustersPerClaim);
+  std::atomic<size_t> next_cluster{0};
+  const auto kWorker = [&]() -> void {
+    LocalSearch search;
+    while (true) {
+      const size_t kBegin =
+          next_cluster.fetch_add(kClustersPerClaim, std::memory_order_relaxed);
+      if (kBegin >= clusters.size()) {
+        return;
+      }
+      const size_t kEnd =
+          std::min(kBegin + kClustersPerClaim, clusters.size());
+      for (size_t index = kBegin; index < kEnd; ++index) {
+        BuildCluster(clusters[index], search);
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> pool;
+    for (size_t worker = 1; worker < worker_count; ++worker) {
+      pool.emplace_back(kWorker);
+    }
+    kWorker();
+  }
+
+  entrance_base_.resize(clusters_.size() + 1);
+  for (size_t cluster = 0; cluster < clusters_.size(); ++cluster) {
+    entrance_base_[cluster + 1] =
+        entrance_base_[cluster] +
+        static_cast<int>(clusters_[cluster].entrances.size());
+  }
+}
+
+void ClusterGraph::BuildCluster(int cluster, LocalSearch& search) {
+  const Bounds kBounds = BoundsOf(cluster);
+  Cluster built;
+  for (int row = kBounds.row_begin; row < kBounds.row_end; ++row) {
+    // Only border cells can cross; interior rows check their two ends.
+    const bool kBorderRow =
+        row == kBounds.row_begin || row == kBounds.row_end - 1;
+    const int kStep = kBorderRow ? 1 : std::max(kBounds.Width() - 1, 1);
+    for (int col = kBounds.col_begin; col < kBounds.col_end; col += kStep) {
+      const int kCell = IndexOf({row, col});
+      for (int dir = 0; dir < MazeDomain::kWallCount; ++dir) {
+        if (Crosses(kCell, dir, kBounds)) {
+          built.entrances.push_back(kCell);
+          break;
+        }
+      }
+    }
+  }
+
+  LoadCluster(cluster, search);
+  built.edge_begin.reserve(built.entrances.size() + 1);
+  built.edge_begin.push_back(0);
+  for (const int kFrom : built.entrances) {
+    SearchCluster(kFrom, search);
+    for (size_t to = 0; to < built.entrances.size(); ++to) {
+      const int kLocal = LocalOf(kBounds, built.entrances[to]);
+      if (built.entrances[to] != kFrom && search.Seen(kLocal)) {
+        built.edges.push_back({.entrance = static_cast<int>(to),
+                               .cost = search.Distance(kLocal)});
+      }
+    }
+    built.edge_begin.push_back(static_cast<int>(built.edges.size()));
+  }
+  clusters_[cluster] = std::move(built);
+}
+
+void ClusterGraph::LoadCluster(int cluster, LocalSearch& search) const {
+  constexpr unsigned kTop = 1U << 0;
+  constexpr unsigned kRight = 1U << 1;
+  constexpr unsigned kBottom = 1U << 2;
+  constexpr unsigned kLeft = 1U << 3;
+  const Bounds kBounds = BoundsOf(cluster);
+  const int kWidth = kBounds.Width();
+  search.cluster_ = cluster;
+  search.offsets_ = {-kWidth, 1, kWidth, -1};
+  search.masks_.resize(static_cast<size_t>(kBounds.CellCount()));
+  auto local_mask = search.masks_.begin();
+  for (int row = kBounds.row_begin; row < kBounds.row_end; ++row) {
+    unsigned row_closed = 0;
+    if (row == kBounds.row_begin) {
+      row_closed |= kTop;
+    }
+    if (row == kBounds.row_end - 1) {
+      row_closed |= kBottom;
+    }
+    const int kRowStart = IndexOf({row, kBounds.col_begin});
+    for (int col = 0; col < kWidth; ++col) {
+      unsigned closed = row_closed;
+      if (col == 0) {
+        closed |= kLeft;
+      }
+      if (col == kWidth - 1) {
+        closed |= kRight;
+      }
+      *local_mask++ =
+          static_cast<std::uint8_t>(masks_[kRowStart + col] & ~closed);
+    }
+  }
+}
+
+void ClusterGraph::SearchCluster(int cell, LocalSearch& search,
+                                 int stop_cell) const {
+  const int kCluster = ClusterOf(cell);
+  if (search.cluster_ != kCluster) {
+    LoadCluster(kCluster, search);
+  }
+  const Bounds kBounds = BoundsOf(kCluster);
+  search.Reset(kBounds.CellCount());
+  search.Reach(LocalOf(kBounds, cell), 0, kNoCell);
+  const int kStopLocal =
+      stop_cell == kNoCell ? kNoCell : LocalOf(kBounds, stop_cell);
+  auto& queue = search.queue_;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const int kLocal = queue[head];
+    if (kLocal == kStopLocal) {
+      return;
+    }
+    const int kNextDistance = search.distance_[kLocal] + 1;
+    unsigned mask = search.masks_[kLocal];
+    while (mask != 0) {
+      const int kNext = kLocal + search.offsets_[std::countr_zero(mask)];
+      mask &= mask - 1;
+      if (!search.Seen(kNext)) {
+        search.Reach(kNext, kNextDistance, kLocal);
+      }
+    }
+  }
+}
+
+auto ClusterGraph::FindPath(GridPosition start_node,
+                            GridPosition end_node) const -> HierarchicalPath {
+  Workspace workspace;
+  return FindPath(start_node, end_node, workspace);
+}
+
+auto ClusterGraph::FindPath(GridPosition start_node, GridPosition end_node,
+                            Workspace& workspace, SearchBudget* budget) const
+    -> HierarchicalPath {
+  HierarchicalPath result;
+  const auto kInside = [this](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < height_ && pos.second >= 0 &&
+           pos.second < width_;
+  };
+  if (!kInside(start_node) || !kInside(end_node)) {
+    return result;
+  }
+  if (start_node == end_node) {
+    result.found_ = true;
+    result.path_.push_back(start_node);
+    return result;
+  }
+
+  // Entrances are nodes 0 .. EntranceCount() - 1; the start gets the next id
+  // even when it is an entrance itself, since it joins its cluster by BFS.
+  const int kStartNode = entrance_base_.back();
+  const auto kNodeCount = static_cast<size_t>(kStartNode) + 1;
+  if (workspace.g_scores_.size() != kNodeCount) {
+    workspace.g_scores_.assign(kNodeCount, 0);
+    workspace.parents_.assign(kNodeCount, kNoCell);
+    workspace.seen_stamp_.assign(kNodeCount, 0);
+    workspace.closed_stamp_.assign(kNodeCount, 0);
+    workspace.epoch_ = 0;
+  }
+  if (++workspace.epoch_ == 0) {
+    std::ranges::fill(workspace.seen_stamp_, 0);
+    std::ranges::fill(workspace.closed_stamp_, 0);
+    workspace.epoch_ = 1;
+  }
+  const std::uint32_t kEpoch = workspace.epoch_;
+  auto& g_scores = workspace.g_scores_;
+  auto& parents = workspace.parents_;
+  auto& heap = workspace.heap_;
+  auto& search = workspace.search_;
+  heap.clear();
+  // Cluster masks cached by an earlier query may predate wall toggles.
+  search.cluster_ = -1;
+
+  const int kStart = IndexOf(start_node);
+  const int kEnd = IndexOf(end_node);
+  const int kEndCluster = ClusterOf(kEnd);
+  const Bounds kEndBounds = BoundsOf(kEndCluster);
+
+  const auto kCharge = [budget](size_t cells) -> bool {
+    return budget == nullptr || budget->SpendMany(cells);
+  };
+
+  // Steps from every cell of the end's cluster to the end, staying inside.
+  SearchCluster(kEnd, search);
+  result.refined_cells_ += search.Reached().size();
+  if (!kCharge(search.Reached().size())) {
+    return result;
+  }
+  auto& end_distance = workspace.end_distance_;
+  end_distance.assign(static_cast<size_t>(kEndBounds.CellCount()),
+                      kUnreachable);
+  for (const int kLocal : search.Reached()) {
+    end_distance[kLocal] = search.Distance(kLocal);
+  }
+
+  const auto kPush = [&](int g_score, int node, int cell) -> void {
+    const GridPosition kPos = PositionOf(cell);
+    const int kHeuristic = std::abs(kPos.first - end_node.first) +
+                           std::abs(kPos.second - end_node.second);
+    heap.push_back({.f_score = g_score + kHeuristic,
+                    .g_score = g_score,
+                    .node = node,
+                    .cell = cell});
+    std::ranges::push_heap(heap, HeapAfter);
+  };
+  const auto kRelax = [&](int from, int node, int cell, int g_score) -> void {
+    if (workspace.closed_stamp_[node] == kEpoch ||
+        (workspace.seen_stamp_[node] == kEpoch && g_scores[node] <= g_score)) {
+      return;
+    }
+    workspace.seen_stamp_[node] = kEpoch;
+    g_scores[node] = g_score;
+    parents[node] = from;
+    kPush(g_score, node, cell);
+  };
+
+  workspace.seen_stamp_[kStartNode] = kEpoch;
+  g_scores[kStartNode] = 0;
+  parents[kStartNode] = kNoCell;
+  kPush(0, kStartNode, kStart);
+  int goal_g = kUnreachable;
+  int goal_parent = kNoCell;
+  while (!heap.empty()) {
+    std::ranges::pop_heap(heap, HeapAfter);
+    const QueueEntry kEntry = heap.back();
+    heap.pop_back();
+    if (kEntry.node == kGoalNode) {
+      result.found_ = true;
+      break;
+    }
+    const int kNode = kEntry.node;
+    if (workspace.closed_stamp_[kNode] == kEpoch ||
+        kEntry.g_score > g_scores[kNode]) {
+      continue;
+    }
+    if (budget != nullptr && !budget->Spend()) {
+      return result;
+    }
+    workspace.closed_stamp_[kNode] = kEpoch;
+    ++result.abstract_expanded_;
+    const int kCell = kEntry.cell;
+    const int kG = kEntry.g_score;
+    const int kCluster = ClusterOf(kCell);
+    const Bounds kBounds = BoundsOf(kCluster);
+
+    if (kCluster == kEndCluster) {
+      const int kToEnd = end_distance[LocalOf(kEndBounds, kCell)];
+      if (kToEnd != kUnreachable && kG + kToEnd < goal_g) {
+        goal_g = kG + kToEnd;
+        goal_parent = kNode;
+        heap.push_back({.f_score = goal_g,
+                        .g_score = goal_g,
+                        .node = kGoalNode,
+                        .cell = kEnd});
+        std::ranges::push_heap(heap, HeapAfter);
+      }
+    }
+
+    const Cluster& cluster = clusters_[kCluster];
+    const int kBase = entrance_base_[kCluster];
+    if (kNode == kStartNode) {
+      SearchCluster(kStart, search);
+      result.refined_cells_ += search.Reached().size();
+      if (!kCharge(search.Reached().size())) {
+        return result;
+      }
+      for (size_t index = 0; index < cluster.entrances.size(); ++index) {
+        const int kEntrance = cluster.entrances[index];
+        const int kLocal = LocalOf(kBounds, kEntrance);
+        if (search.Seen(kLocal)) {
+          kRelax(kNode, kBase + static_cast<int>(index), kEntrance,
+                 kG + search.Distance(kLocal));
+        }
+      }
+    } else {
+      const int kIndex = kNode - kBase;
+      for (int edge = cluster.edge_begin[kIndex];
+           edge < cluster.edge_begin[kIndex + 1]; ++edge) {
+        const Edge& link = cluster.edges[edge];
+        kRelax(kNode, kBase + link.entrance, cluster.entrances[link.entrance],
+               kG + link.cost);
+      }
+    }
+    for (int dir = 0; dir < MazeDomain::kWallCount; ++dir) {
+      if (Crosses(kCell, dir, kBounds)) {
+        const int kNext = kCell + offsets_[dir];
+        kRelax(kNode, NodeOf(ClusterOf(kNext), kNext), kNext, kG + 1);
+      }
+    }
+  }
+  if (!result.found_) {
+    return result;
+  }
+
+  std::vector<int> chain = {kEnd};
+  for (int node = goal_parent; node != kNoCell; node = parents[node]) {
+    const int kCell = node == kStartNode ? kStart : CellOfNode(node);
+    if (kCell != chain.back()) {
+      chain.push_back(kCell);
+    }
+  }
+  std::ranges::reverse(chain);
+  std::vector<int> cells = {kStart};
+  for (size_t index = 1; index < chain.size(); ++index) {
+    if (!AppendRefined(chain[index - 1], chain[index], cells, search,
+                       result.refined_cells_, budget)) {
+      result.found_ = false;
+      return result;
+    }
+  }
+  result.length_ = goal_g;
+  result.path_.reserve(cells.size());
+  for (const int kCell : cells) {
+    result.path_.push_back(PositionOf(kCell));
+  }
+  return result;
+}
+
+auto ClusterGraph::AppendRefined(int from, int to, std::vector<int>& cells,
+                                 LocalSearch& search, size_t& refined_cells,
+                                 SearchBudget* budget) const -> bool {
+  const int kCluster = ClusterOf(from);
+  if (ClusterOf(to) != kCluster) {
+    cells.push_back(to);
+    return true;
+  }
+  const Bounds kBounds = BoundsOf(kCluster);
+  SearchCluster(from, search, to);
+  refined_cells += search.Reached().size();
+  if (budget != nullptr && !budget->SpendMany(search.Reached().size())) {
+    return false;
+  }
+  const size_t kFirst = cells.size();
+  for (int local = LocalOf(kBounds, to); search.Parent(local) != kNoCell;
+       local = search.Parent(local)) {
+    cells.push_back(CellOf(kBounds, local));
+  }
+  std::reverse(cells.begin() + static_cast<std::ptrdiff_t>(kFirst),
+               cells.end());
+  return true;
+}
+
+auto ClusterGraph::ApplyWallToggles(std::span<const WallToggle> toggles,
+                                    unsigned threads) -> size_t {
+  const auto kInside = [this](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < height_ && pos.second >= 0 &&
+           pos.second < width_;
+  };
+  std::vector<int> dirty;
+  for (const auto& toggle : toggles) {
+    if (toggle.wall < 0 || toggle.wall >= MazeDomain::kWallCount ||
+        !kInside(toggle.cell)) {
+      continue;
+    }
+    const GridPosition kOther = {
+        toggle.cell.first + MazeAdjacency::kRowDelta[toggle.wall],
+        toggle.cell.second + MazeAdjacency::kColDelta[toggle.wall]};
+    if (!kInside(kOther)) {
+      continue;
+    }
+    const int kCell = IndexOf(toggle.cell);
+    const int kOtherCell = IndexOf(kOther);
+    const auto kBit = static_cast<std::uint8_t>(1U << toggle.wall);
+    const auto kOtherBit = static_cast<std::uint8_t>(
+        1U << MazeAdjacency::Opposite(toggle.wall));
+    if ((masks_[kCell] & kBit) != 0) {
+      masks_[kCell] &= static_cast<std::uint8_t>(~kBit);
+      masks_[kOtherCell] &= static_cast<std::uint8_t>(~kOtherBit);
+    } else {
+      masks_[kCell] |= kBit;
+      masks_[kOtherCell] |= kOtherBit;
+    }
+    dirty.push_back(ClusterOf(kCell));
+    dirty.push_back(ClusterOf(kOtherCell));
+  }
+  std::ranges::sort(dirty);
+  const auto kDuplicates = std::ranges::unique(dirty);
+  dirty.erase(kDuplicates.begin(), kDuplicates.end());
+  BuildClusters(dirty, threads);
+  return dirty.size();
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,190 @@
+#ifndef MAZE_DOMAIN_MAZE_CLUSTER_GRAPH_H
+#define MAZE_DOMAIN_MAZE_CLUSTER_GRAPH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_incremental_planner.h"
+#include "domain/maze_search_budget.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+struct HierarchicalPath {
+  bool found_ = false;
+  int length_ = 0;
+  std::vector<GridPosition> path_;
+  // Abstract nodes expanded, and cells touched while refining.
+  size_t abstract_expanded_ = 0;
+  size_t refined_cells_ = 0;
+};
+
+// HPA*-style abstraction for very large mazes. The grid is cut into square
+// clusters; every cell with an open passage across its cluster's border is an
+// entrance, and each cluster stores the BFS distance between every pair of
+// its entrances that meet inside it. A query joins start and end to their
+// clusters' entrances, runs A* over entrances only (intra-cluster edges plus
+// the unit crossings between clusters) and then refines just the clusters on
+// the abstract path with a BFS confined to each. Every border crossing is its
+// own entrance, so the abstract distance is the true shortest distance.
+//
+// Clusters are independent, so the build is split across `threads` workers
+// (0 = std::thread::hardware_concurrency()), and ApplyWallToggles() rebuilds
+// only the clusters on either side of each toggled wall. FindPath is const
+// and safe to run concurrently; toggles must not overlap with queries.
+class ClusterGraph {
+ public:
+  static constexpr int kDefaultClusterSize = 32;
+
+ private:
+  // Scratch BFS over one cluster, indexed by cluster-local cell. The cluster's
+  // open masks are copied in once, with passages that leave it closed, so
+  // repeated searches of the same cluster never bounds-check.
+  class LocalSearch {
+   public:
+    auto Seen(int local) const -> bool { return stamp_[local] == epoch_; }
+    auto Distance(int local) const -> int { return distance_[local]; }
+    auto Parent(int local) const -> int { return parent_[local]; }
+    auto Reached() const -> const std::vector<int>& { return queue_; }
+
+   private:
+    friend class ClusterGraph;
+
+    void Reset(int cell_count);
+    void Reach(int local, int distance, int parent);
+
+    int cluster_ = -1;
+    std::array<int, MazeDomain::kWallCount> offsets_{};
+    std::vector<std::uint8_t> masks_;
+    std::vector<std::uint32_t> stamp_;
+    std::vector<int> distance_;
+    std::vector<int> parent_;
+    std::vector<int> queue_;
+    std::uint32_t epoch_ = 0;
+  };
+
+  struct QueueEntry {
+    int f_score;
+    int g_score;
+    int node;
+    int cell;
+  };
+
+ public:
+  // Per-caller query state, sized to the entrance count and reset in O(1)
+  // between queries.
+  class Workspace {
+   private:
+    friend class ClusterGraph;
+
+    std::vector<int> g_scores_;
+    std::vector<int> parents_;
+    std::vector<std::uint32_t> seen_stamp_;
+    std::vector<std::uint32_t> closed_stamp_;
+    std::vector<QueueEntry> heap_;
+    std::vector<int> end_distance_;
+    LocalSearch search_;
+    std::uint32_t epoch_ = 0;
+  };
+
+  ClusterGraph(const MazeDomain::MazeGrid& maze_grid, int cluster_size,
+               unsigned threads);
+
+  auto Height() const -> int { return height_; }
+  auto Width() const -> int { return width_; }
+  auto ClusterSize() const -> int { return cluster_size_; }
+  auto ClusterCount() const -> int {
+    return static_cast<int>(clusters_.size());
+  }
+  auto EntranceCount() const -> size_t {
+    return static_cast<size_t>(entrance_base_.back());
+  }
+  size_t EdgeCount() const;
+
+  HierarchicalPath FindPath(GridPosition start_node,
+                            GridPosition end_node) const;
+  // With `budget`, every abstract expansion and every cell a cluster BFS
+  // reaches (joining the endpoints, refining) is charged to it; a cluster
+  // BFS is charged once it finishes, so the node limit may be passed by one
+  // cluster. A stopped query reports no path.
+  HierarchicalPath FindPath(GridPosition start_node, GridPosition end_node,
+                            Workspace& workspace,
+                            SearchBudget* budget = nullptr) const;
+
+  // Returns the number of clusters rebuilt; toggles on the outer border or
+  // outside the maze are ignored, as in IncrementalPlanner.
+  size_t ApplyWallToggles(std::span<const WallToggle> toggles,
+                          unsigned threads = 1);
+
+ private:
+  // `entrance` indexes the same cluster's entrances.
+  struct Edge {
+    int entrance;
+    int cost;
+  };
+
+  struct Cluster {
+    // Sorted cell indices; edges of entrances[i] are
+    // edges[edge_begin[i] .. edge_begin[i + 1]).
+    std::vector<int> entrances;
+    std::vector<int> edge_begin;
+    std::vector<Edge> edges;
+  };
+
+  // Cell rectangle [row_begin, row_end) x [col_begin, col_end).
+  struct Bounds {
+    int row_begin;
+    int row_end;
+    int col_begin;
+    int col_end;
+
+    auto Width() const -> int { return col_end - col_begin; }
+    auto CellCount() const -> int {
+      return (row_end - row_begin) * (col_end - col_begin);
+    }
+  };
+
+  auto IndexOf(GridPosition pos) const -> int {
+    return (pos.first * width_) + pos.second;
+  }
+  auto PositionOf(int cell) const -> GridPosition {
+    return {cell / width_, cell % width_};
+  }
+  auto ClusterOf(int cell) const -> int;
+  auto BoundsOf(int cluster) const -> Bounds;
+  auto LocalOf(const Bounds& bounds, int cell) const -> int;
+  auto CellOf(const Bounds& bounds, int local) const -> int;
+  auto Crosses(int cell, int dir, const Bounds& bounds) const -> bool;
+  // Abstract node ids: entrances numbered cluster by cluster.
+  auto NodeOf(int cluster, int cell) const -> int;
+  auto CellOfNode(int node) const -> int;
+
+  void BuildClusters(std::span<const int> clusters, unsigned threads);
+  void BuildCluster(int cluster, LocalSearch& search);
+  void LoadCluster(int cluster, LocalSearch& search) const;
+  // BFS from `cell` that never leaves its cluster; it may stop once
+  // `stop_cell` is dequeued.
+  void SearchCluster(int cell, LocalSearch& search, int stop_cell = -1) const;
+  // False when `budget` stops the refinement.
+  auto AppendRefined(int from, int to, std::vector<int>& cells,
+                     LocalSearch& search, size_t& refined_cells,
+                     SearchBudget* budget) const -> bool;
+
+  int height_ = 0;
+  int width_ = 0;
+  int cluster_size_ = kDefaultClusterSize;
+  int cluster_cols_ = 0;
+  std::array<int, MazeDomain::kWallCount> offsets_{};
+  std::vector<std::uint8_t> masks_;
+  std::vector<Cluster> clusters_;
+  // Prefix sums of the entrance counts, one past the last cluster.
+  std::vector<int> entrance_base_ = {0};
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_CLUSTER_GRAPH_H
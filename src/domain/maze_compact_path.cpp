@@ -0,0 +1,66 @@
+#include "domain/maze_compact_path.h"
+
+namespace MazeSolverDomain {
+
+auto CompactPath::FromPath(std::span<const GridPosition> path)
+    -> CompactPath {
+  CompactPath compact;
+  if (path.empty()) {
+    return compact;
+  }
+  compact.start_ = path.front();
+  compact.end_ = path.back();
+  compact.empty_ = false;
+  for (size_t index = 1; index < path.size(); ++index) {
+    const int kRowStep = path[index].first - path[index - 1].first;
+    const int kColStep = path[index].second - path[index - 1].second;
+    const int kDir = kRowStep < 0   ? 0
+                     : kColStep > 0 ? 1
+                     : kRowStep > 0 ? 2
+                                    : 3;
+    compact.AddStep(kDir);
+  }
+  return compact;
+}
+
+auto CompactPath::FromRuns(GridPosition start, std::span<const Run> runs)
+    -> std::optional<CompactPath> {
+  CompactPath compact;
+  compact.start_ = start;
+  compact.end_ = start;
+  compact.empty_ = false;
+  compact.runs_.assign(runs.begin(), runs.end());
+  for (const Run kRun : runs) {
+    const Run kSteps = kRun & kMaxRunSteps;
+    if (kSteps == 0) {
+      return std::nullopt;
+    }
+    const auto kDir = static_cast<size_t>(kRun >> kCountBits);
+    compact.end_.first += kRowDelta[kDir] * kSteps;
+    compact.end_.second += kColDelta[kDir] * kSteps;
+    compact.steps_ += kSteps;
+  }
+  return compact;
+}
+
+auto CompactPath::ToPath() const -> std::vector<GridPosition> {
+  std::vector<GridPosition> path;
+  path.reserve(CellCount());
+  for (Iterator cell = begin(); cell != end(); ++cell) {
+    path.push_back(*cell);
+  }
+  return path;
+}
+
+void CompactPath::AddStep(int dir) {
+  const auto kDirBits = static_cast<Run>(dir << kCountBits);
+  if (!runs_.empty() && (runs_.back() >> kCountBits) == dir &&
+      (runs_.back() & kMaxRunSteps) < kMaxRunSteps) {
+    ++runs_.back();
+  } else {
+    runs_.push_back(static_cast<Run>(kDirBits | 1U));
+  }
+  ++steps_;
+}
+
+}  // namespace MazeSolverDomain
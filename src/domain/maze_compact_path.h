@@ -0,0 +1,138 @@
+#ifndef MAZE_DOMAIN_MAZE_COMPACT_PATH_H
+#define MAZE_DOMAIN_MAZE_COMPACT_PATH_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace MazeSolverDomain {
+
+using GridPosition = std::pair<int, int>;
+
+// A path as its start cell and runs of steps in one direction, one byte per
+// run: the direction (MazeAdjacency order: up, right, down, left) in the top
+// two bits, 1-63 steps below; longer straights take several runs. Against
+// the 8 bytes per cell of std::vector<GridPosition> that is at least 8x
+// smaller for any path, and more the longer its straights are.
+class CompactPath {
+ public:
+  using Run = std::uint8_t;
+  static constexpr int kCountBits = 6;
+  static constexpr Run kMaxRunSteps = (Run{1} << kCountBits) - 1;
+  static constexpr std::array<int, 4> kRowDelta = {-1, 0, 1, 0};
+  static constexpr std::array<int, 4> kColDelta = {0, 1, 0, -1};
+
+  // Cells start -> end, decoded one run step at a time.
+  class Iterator {
+   public:
+    using value_type = GridPosition;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    Iterator(std::span<const Run> runs, GridPosition start)
+        : runs_(runs), pos_(start), done_(false) {}
+
+    auto operator*() const -> GridPosition { return pos_; }
+    auto operator++() -> Iterator& {
+      if (run_ == runs_.size()) {
+        done_ = true;
+        return *this;
+      }
+      const Run kRun = runs_[run_];
+      const auto kDir = static_cast<int>(kRun >> kCountBits);
+      pos_.first += kRowDelta[kDir];
+      pos_.second += kColDelta[kDir];
+      if (++taken_ == (kRun & kMaxRunSteps)) {
+        ++run_;
+        taken_ = 0;
+      }
+      return *this;
+    }
+    auto operator++(int) -> Iterator {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    auto operator==(std::default_sentinel_t /*end*/) const -> bool {
+      return done_;
+    }
+
+   private:
+    std::span<const Run> runs_;
+    size_t run_ = 0;
+    Run taken_ = 0;
+    GridPosition pos_ = {0, 0};
+    bool done_ = true;
+  };
+
+  // Every consecutive pair of cells must be neighbours.
+  static auto FromPath(std::span<const GridPosition> path) -> CompactPath;
+
+  // Rebuilds a path from its Start() and Runs(); nullopt if a run has no
+  // steps.
+  static auto FromRuns(GridPosition start, std::span<const Run> runs)
+      -> std::optional<CompactPath>;
+
+  // Follows parent links back from `end` until `start`, or until
+  // parent_of(cell) is negative, without building the cell list. Cells are
+  // row-major indices of a `width` wide grid.
+  template <typename ParentOf>
+  static auto FromParents(int width, int start, int end, ParentOf parent_of)
+      -> CompactPath {
+    CompactPath path;
+    path.end_ = {end / width, end % width};
+    int cell = end;
+    while (cell != start) {
+      const int kParent = parent_of(cell);
+      if (kParent < 0) {
+        break;
+      }
+      const int kStep = cell - kParent;
+      const int kDir = kStep == width    ? 2
+                       : kStep == -width ? 0
+                       : kStep == 1      ? 1
+                                         : 3;
+      path.AddStep(kDir);
+      cell = kParent;
+    }
+    path.start_ = {cell / width, cell % width};
+    path.empty_ = false;
+    // Runs were added end -> start.
+    std::reverse(path.runs_.begin(), path.runs_.end());
+    return path;
+  }
+
+  auto Empty() const -> bool { return empty_; }
+  // Cells on the path, start and end included; 0 when empty.
+  auto CellCount() const -> size_t { return empty_ ? 0 : steps_ + 1; }
+  auto Start() const -> GridPosition { return start_; }
+  auto End() const -> GridPosition { return end_; }
+  auto Runs() const -> std::span<const Run> { return runs_; }
+  auto Bytes() const -> size_t { return runs_.size() * sizeof(Run); }
+
+  auto begin() const -> Iterator {
+    return empty_ ? Iterator() : Iterator(runs_, start_);
+  }
+  auto end() const -> std::default_sentinel_t { return {}; }
+
+  auto ToPath() const -> std::vector<GridPosition>;
+
+ private:
+  void AddStep(int dir);
+
+  GridPosition start_ = {0, 0};
+  GridPosition end_ = {0, 0};
+  size_t steps_ = 0;
+  std::vector<Run> runs_;
+  bool empty_ = true;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_COMPACT_PATH_H
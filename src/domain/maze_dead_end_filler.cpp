@@ -0,0 +1,269 @@
+#include "domain/maze_dead_end_filler.h"
+
+#include <bit>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr size_t kWordBits = 64;
+constexpr int kTop = 0;
+constexpr int kRight = 1;
+constexpr int kBottom = 2;
+constexpr int kLeft = 3;
+// A pass that seals fewer cells than words / kTailWordsPerCell hands over to
+// the worklist.
+constexpr size_t kTailWordsPerCell = 4;
+
+// Live cells plus the open passages to the right of and below every cell,
+// in the DeadEndFill word layout. Endpoints are pinned and never sealed.
+class PackedMaze {
+ public:
+  PackedMaze(const MazeAdjacency& adjacency, DeadEndFill& fill)
+      : height_(adjacency.Height()),
+        width_(adjacency.Width()),
+        words_per_row_(fill.words_per_row_),
+        live_(fill.live_),
+        right_(live_.size(), 0),
+        down_(live_.size(), 0),
+        pinned_(live_.size(), 0) {
+    for (int row = 0; row < height_; ++row) {
+      for (int col = 0; col < width_; ++col) {
+        const unsigned kMask = adjacency.OpenMask((row * width_) + col);
+        const size_t kWord = WordOf(row, col);
+        const auto kShift = static_cast<size_t>(col) % kWordBits;
+        live_[kWord] |= std::uint64_t{1} << kShift;
+        right_[kWord] |= static_cast<std::uint64_t>((kMask >> kRight) & 1U)
+                         << kShift;
+        down_[kWord] |= static_cast<std::uint64_t>((kMask >> kBottom) & 1U)
+                        << kShift;
+      }
+    }
+  }
+
+  void Pin(GridPosition pos) {
+    pinned_[WordOf(pos.first, pos.second)] |= BitOf(pos.second);
+  }
+
+  // One sweep over every word, top to bottom or bottom to top; returns the
+  // number of cells sealed.
+  auto Pass(bool downwards) -> size_t {
+    size_t sealed = 0;
+    for (int step = 0; step < height_; ++step) {
+      const int kRow = downwards ? step : height_ - 1 - step;
+      for (size_t step_word = 0; step_word < words_per_row_; ++step_word) {
+        const size_t kWord =
+            downwards ? step_word : words_per_row_ - 1 - step_word;
+        sealed += SealWord(kRow, kWord);
+      }
+    }
+    return sealed;
+  }
+
+  // Classic dead-end filling for the tail: seeded with the dead ends the
+  // passes left, it follows each corridor cell by cell, so it only touches
+  // cells next to something it sealed.
+  auto FinishWithWorklist() -> size_t {
+    std::vector<GridPosition> stack;
+    for (int row = 0; row < height_; ++row) {
+      for (size_t word = 0; word < words_per_row_; ++word) {
+        std::uint64_t dead = DeadEnds(row, word);
+        while (dead != 0) {
+          stack.emplace_back(row, static_cast<int>((word * kWordBits) +
+                                                   std::countr_zero(dead)));
+          dead &= dead - 1;
+        }
+      }
+    }
+
+    size_t sealed = 0;
+    while (!stack.empty()) {
+      const GridPosition kCell = stack.back();
+      stack.pop_back();
+      if (!IsLive(kCell)) {
+        continue;
+      }
+      live_[WordOf(kCell.first, kCell.second)] &= ~BitOf(kCell.second);
+      ++sealed;
+      unsigned sides = OpenSides(kCell);
+      while (sides != 0) {
+        const int kDir = std::countr_zero(sides);
+        sides &= sides - 1;
+        const GridPosition kNext = {
+            kCell.first + MazeAdjacency::kRowDelta[kDir],
+            kCell.second + MazeAdjacency::kColDelta[kDir]};
+        if (IsLive(kNext) && !IsPinned(kNext) && LiveDegree(kNext) <= 1) {
+          stack.push_back(kNext);
+        }
+      }
+    }
+    return sealed;
+  }
+
+ private:
+  auto WordOf(int row, int col) const -> size_t {
+    return (static_cast<size_t>(row) * words_per_row_) +
+           (static_cast<size_t>(col) / kWordBits);
+  }
+  static auto BitOf(int col) -> std::uint64_t {
+    return std::uint64_t{1} << (static_cast<size_t>(col) % kWordBits);
+  }
+  static auto Test(const std::vector<std::uint64_t>& bits, size_t word,
+                   int col) -> bool {
+    return (bits[word] & BitOf(col)) != 0;
+  }
+  auto IsLive(GridPosition pos) const -> bool {
+    return Test(live_, WordOf(pos.first, pos.second), pos.second);
+  }
+  auto IsPinned(GridPosition pos) const -> bool {
+    return Test(pinned_, WordOf(pos.first, pos.second), pos.second);
+  }
+
+  // MazeAdjacency direction bits of the cell's open sides.
+  auto OpenSides(GridPosition pos) const -> unsigned {
+    const auto [row, col] = pos;
+    const size_t kWord = WordOf(row, col);
+    unsigned sides = 0;
+    if (row > 0 && Test(down_, kWord - words_per_row_, col)) {
+      sides |= 1U << kTop;
+    }
+    if (Test(right_, kWord, col)) {
+      sides |= 1U << kRight;
+    }
+    if (Test(down_, kWord, col)) {
+      sides |= 1U << kBottom;
+    }
+    if (col > 0 && Test(right_, WordOf(row, col - 1), col - 1)) {
+      sides |= 1U << kLeft;
+    }
+    return sides;
+  }
+  auto LiveDegree(GridPosition pos) const -> int {
+    int degree = 0;
+    unsigned sides = OpenSides(pos);
+    while (sides != 0) {
+      const int kDir = std::countr_zero(sides);
+      sides &= sides - 1;
+      degree += IsLive({pos.first + MazeAdjacency::kRowDelta[kDir],
+                        pos.second + MazeAdjacency::kColDelta[kDir]})
+                    ? 1
+                    : 0;
+    }
+    return degree;
+  }
+
+  // Unpinned live cells of the word with fewer than two open sides leading
+  // to a live neighbour.
+  auto DeadEnds(int row, size_t word_in_row) const -> std::uint64_t {
+    const size_t kWord =
+        (static_cast<size_t>(row) * words_per_row_) + word_in_row;
+    const std::uint64_t kLive = live_[kWord];
+    const std::uint64_t kUp =
+        row > 0 ? down_[kWord - words_per_row_] & live_[kWord - words_per_row_]
+                : 0;
+    const std::uint64_t kDown =
+        row + 1 < height_ ? down_[kWord] & live_[kWord + words_per_row_] : 0;
+    // Bit 0 of the next word is the right neighbour of bit 63, and bit 63 of
+    // the previous word the left neighbour of bit 0.
+    const std::uint64_t kRightOpen =
+        right_[kWord] &
+        ((kLive >> 1) |
+         (word_in_row + 1 < words_per_row_ ? live_[kWord + 1] << 63 : 0));
+    const std::uint64_t kLeftOpen =
+        ((right_[kWord] & kLive) << 1) |
+        (word_in_row > 0 ? (right_[kWord - 1] & live_[kWord - 1]) >> 63 : 0);
+    const std::uint64_t kTwoOrMore =
+        ((kUp | kDown) & (kLeftOpen | kRightOpen)) | (kUp & kDown) |
+        (kLeftOpen & kRightOpen);
+    return kLive & ~kTwoOrMore & ~pinned_[kWord];
+  }
+
+  // Seals the word's dead ends until none are left in it, so a dead-end run
+  // along the row goes in one call.
+  auto SealWord(int row, size_t word_in_row) -> size_t {
+    std::uint64_t& live =
+        live_[(static_cast<size_t>(row) * words_per_row_) + word_in_row];
+    size_t sealed = 0;
+    for (std::uint64_t dead = DeadEnds(row, word_in_row); dead != 0;
+         dead = DeadEnds(row, word_in_row)) {
+      live &= ~dead;
+      sealed += static_cast<size_t>(std::popcount(dead));
+    }
+    return sealed;
+  }
+
+  int height_;
+  int width_;
+  size_t words_per_row_;
+  std::vector<std::uint64_t>& live_;
+  std::vector<std::uint64_t> right_;
+  std::vector<std::uint64_t> down_;
+  std::vector<std::uint64_t> pinned_;
+};
+
+}  // namespace
+
+auto FillDeadEnds(const MazeAdjacency& adjacency, GridPosition start_node,
+                  GridPosition end_node) -> DeadEndFill {
+  DeadEndFill fill;
+  fill.height_ = adjacency.Height();
+  fill.width_ = adjacency.Width();
+  fill.words_per_row_ =
+      (static_cast<size_t>(fill.width_) + kWordBits - 1) / kWordBits;
+  fill.live_.assign(static_cast<size_t>(fill.height_) * fill.words_per_row_,
+                    0);
+  if (adjacency.CellCount() == 0) {
+    return fill;
+  }
+
+  PackedMaze packed(adjacency, fill);
+  const auto kInside = [&adjacency](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < adjacency.Height() &&
+           pos.second >= 0 && pos.second < adjacency.Width();
+  };
+  for (const GridPosition& endpoint : {start_node, end_node}) {
+    if (kInside(endpoint)) {
+      packed.Pin(endpoint);
+    }
+  }
+
+  const size_t kWordCount = fill.live_.size();
+  bool downwards = true;
+  while (true) {
+    const size_t kSealed = packed.Pass(downwards);
+    downwards = !downwards;
+    ++fill.bit_passes_;
+    fill.filled_ += kSealed;
+    if (kSealed == 0) {
+      return fill;
+    }
+    if (kSealed * kTailWordsPerCell < kWordCount) {
+      break;
+    }
+  }
+  fill.worklist_filled_ = packed.FinishWithWorklist();
+  fill.filled_ += fill.worklist_filled_;
+  return fill;
+}
+
+void SealFilledCells(MazeDomain::MazeGrid& maze_grid,
+                     const DeadEndFill& fill) {
+  for (int row = 0; row < fill.height_; ++row) {
+    for (int col = 0; col < fill.width_; ++col) {
+      if (fill.IsLive({row, col})) {
+        continue;
+      }
+      for (int dir = 0; dir < MazeAdjacency::kDirectionCount; ++dir) {
+        maze_grid[row][col].walls[dir] = true;
+        const int kRow = row + MazeAdjacency::kRowDelta[dir];
+        const int kCol = col + MazeAdjacency::kColDelta[dir];
+        if (kRow >= 0 && kRow < fill.height_ && kCol >= 0 &&
+            kCol < fill.width_) {
+          maze_grid[kRow][kCol].walls[MazeAdjacency::Opposite(dir)] = true;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace MazeSolverDomain
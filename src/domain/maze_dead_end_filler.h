@@ -0,0 +1,55 @@
+#ifndef MAZE_DOMAIN_MAZE_DEAD_END_FILLER_H
+#define MAZE_DOMAIN_MAZE_DEAD_END_FILLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Cells left after dead-end filling, one bit per cell in row-major words
+// (each row starts a new word).
+struct DeadEndFill {
+  int height_ = 0;
+  int width_ = 0;
+  size_t words_per_row_ = 0;
+  std::vector<std::uint64_t> live_;
+  size_t filled_ = 0;
+  int bit_passes_ = 0;
+  // Cells sealed by the worklist once the passes stopped paying off.
+  size_t worklist_filled_ = 0;
+
+  auto IsLive(GridPosition pos) const -> bool {
+    const size_t kWord = (static_cast<size_t>(pos.first) * words_per_row_) +
+                         (static_cast<size_t>(pos.second) / 64);
+    return ((live_[kWord] >> (pos.second % 64)) & 1U) != 0;
+  }
+};
+
+// Repeatedly seals every cell other than start and end with at most one open
+// passage to a live neighbour. No simple start -> end path runs through a
+// dead end, so every such path survives; in a perfect maze only the solution
+// is left, elsewhere the loops it touches stay too.
+//
+// The grid is packed into live / open-right / open-down bit rows, and a pass
+// sweeps them a 64-cell word at a time: the four "live neighbour through an
+// open side" masks come from shifts and ANDs, and "fewer than two of them"
+// is ~((a|b)&(c|d) | a&b | c&d), without counting bits. Words are updated in
+// place, re-run until stable within the word, and the sweeps alternate
+// downwards and upwards, so a corridor dies in one pass per change of
+// direction. Once a pass seals only a few cells per hundred words, the rest
+// is finished with a degree-counting worklist.
+DeadEndFill FillDeadEnds(const MazeAdjacency& adjacency,
+                         GridPosition start_node, GridPosition end_node);
+
+// Closes every passage into a filled cell, so any solver run on the result
+// only sees the live cells.
+void SealFilledCells(MazeDomain::MazeGrid& maze_grid, const DeadEndFill& fill);
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_DEAD_END_FILLER_H
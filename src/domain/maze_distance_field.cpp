@@ -0,0 +1,325 @@
+#include "domain/maze_distance_field.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Levels that scan fewer cells than this stay on the calling thread: the
+// frontier for top-down steps, every cell for bottom-up steps.
+constexpr size_t kParallelWork = 4096;
+// Direction-optimizing thresholds (Beamer et al.): go bottom-up once the
+// frontier's edges exceed 1/alpha of the unexplored edges, and only while
+// the frontier holds at least 1/beta of all cells.
+constexpr std::uint64_t kAlpha = 14;
+constexpr std::uint64_t kBeta = 24;
+
+// Fork-join pool for the parallel levels. Worker 0 is the calling thread;
+// the others sleep on a barrier between levels.
+class LevelWorkers {
+ public:
+  explicit LevelWorkers(unsigned count)
+      : start_(count), done_(count) {
+    threads_.reserve(count - 1);
+    for (unsigned worker = 1; worker < count; ++worker) {
+      threads_.emplace_back([this, worker]() -> void { Loop(worker); });
+    }
+  }
+
+  LevelWorkers(const LevelWorkers&) = delete;
+  auto operator=(const LevelWorkers&) -> LevelWorkers& = delete;
+
+  ~LevelWorkers() {
+    stop_ = true;
+    start_.arrive_and_wait();
+  }
+
+  void Run(std::function<void(unsigned)> task) {
+    task_ = std::move(task);
+    start_.arrive_and_wait();
+    task_(0);
+    done_.arrive_and_wait();
+  }
+
+ private:
+  void Loop(unsigned worker) {
+    while (true) {
+      start_.arrive_and_wait();
+      if (stop_) {
+        return;
+      }
+      task_(worker);
+      done_.arrive_and_wait();
+    }
+  }
+
+  std::barrier<> start_;
+  std::barrier<> done_;
+  std::function<void(unsigned)> task_;
+  bool stop_ = false;
+  std::vector<std::jthread> threads_;
+};
+
+template <bool kConcurrent>
+auto LoadDistance(std::vector<std::uint32_t>& distances, int cell)
+    -> std::uint32_t {
+  if constexpr (kConcurrent) {
+    return std::atomic_ref<std::uint32_t>(distances[cell])
+        .load(std::memory_order_relaxed);
+  } else {
+    return distances[cell];
+  }
+}
+
+template <bool kConcurrent>
+auto TopDownStep(const MazeAdjacency& adjacency,
+                 std::vector<std::uint32_t>& distances,
+                 std::span<const int> frontier, std::uint32_t level,
+                 std::vector<int>& next) -> std::uint64_t {
+  std::uint64_t edges = 0;
+  for (const int kCell : frontier) {
+    unsigned mask = adjacency.OpenMask(kCell);
+    while (mask != 0) {
+      const int kNext = adjacency.Neighbor(kCell, std::countr_zero(mask));
+      mask &= mask - 1;
+      ++edges;
+      if constexpr (kConcurrent) {
+        std::uint32_t expected = kUnreachedDistance;
+        if (std::atomic_ref<std::uint32_t>(distances[kNext])
+                .compare_exchange_strong(expected, level + 1,
+                                         std::memory_order_relaxed)) {
+          next.push_back(kNext);
+        }
+      } else if (distances[kNext] == kUnreachedDistance) {
+        distances[kNext] = level + 1;
+        next.push_back(kNext);
+      }
+    }
+  }
+  return edges;
+}
+
+template <bool kConcurrent>
+auto BottomUpStep(const MazeAdjacency& adjacency,
+                  std::vector<std::uint32_t>& distances, int cell_begin,
+                  int cell_end, std::uint32_t level, std::vector<int>& next)
+    -> std::uint64_t {
+  std::uint64_t edges = 0;
+  for (int cell = cell_begin; cell < cell_end; ++cell) {
+    if (LoadDistance<kConcurrent>(distances, cell) != kUnreachedDistance) {
+      continue;
+    }
+    unsigned mask = adjacency.OpenMask(cell);
+    while (mask != 0) {
+      const int kParent = adjacency.Neighbor(cell, std::countr_zero(mask));
+      mask &= mask - 1;
+      ++edges;
+      if (LoadDistance<kConcurrent>(distances, kParent) == level) {
+        if constexpr (kConcurrent) {
+          std::atomic_ref<std::uint32_t>(distances[cell])
+              .store(level + 1, std::memory_order_relaxed);
+        } else {
+          distances[cell] = level + 1;
+        }
+        next.push_back(cell);
+        break;
+      }
+    }
+  }
+  return edges;
+}
+
+void Concatenate(std::vector<std::vector<int>>& parts, std::vector<int>& out) {
+  out.clear();
+  for (auto& part : parts) {
+    out.insert(out.end(), part.begin(), part.end());
+    part.clear();
+  }
+}
+
+}  // namespace
+
+auto ComputeDistanceField(const MazeAdjacency& adjacency, GridPosition source,
+                          unsigned threads) -> DistanceField {
+  const auto kStartTime = Clock::now();
+  DistanceField field;
+  field.height_ = adjacency.Height();
+  field.width_ = adjacency.Width();
+  const int kCellCount = adjacency.CellCount();
+  field.distances_.assign(static_cast<size_t>(kCellCount), kUnreachedDistance);
+  if (source.first < 0 || source.first >= field.height_ || source.second < 0 ||
+      source.second >= field.width_) {
+    return field;
+  }
+
+  const unsigned kWorkerCount =
+      threads == 0 ? std::max(1U, std::thread::hardware_concurrency())
+                   : threads;
+  std::optional<LevelWorkers> workers;
+  std::vector<std::vector<int>> partial_next(kWorkerCount);
+  std::vector<std::uint64_t> partial_edges(kWorkerCount, 0);
+
+  std::uint64_t unexplored_edges = 0;
+  for (int cell = 0; cell < kCellCount; ++cell) {
+    unexplored_edges += static_cast<std::uint64_t>(adjacency.Degree(cell));
+  }
+
+  auto& distances = field.distances_;
+  auto& stats = field.stats_;
+  std::vector<int> frontier = {adjacency.IndexOf(source)};
+  std::vector<int> next;
+  distances[frontier.front()] = 0;
+  std::uint64_t frontier_edges =
+      static_cast<std::uint64_t>(adjacency.Degree(frontier.front()));
+  unexplored_edges -= frontier_edges;
+  stats.reached_cells_ = 1;
+  bool bottom_up = false;
+
+  for (std::uint32_t level = 0; !frontier.empty(); ++level) {
+    const size_t kPreviousSize = frontier.size();
+    const bool kWideFrontier =
+        frontier.size() * kBeta >= static_cast<size_t>(kCellCount);
+    if (!bottom_up) {
+      bottom_up = kWideFrontier && frontier_edges * kAlpha > unexplored_edges;
+    } else {
+      bottom_up = kWideFrontier;
+    }
+    const size_t kLevelWork =
+        bottom_up ? static_cast<size_t>(kCellCount) : frontier.size();
+    const bool kParallel = kWorkerCount > 1 && kLevelWork >= kParallelWork;
+    if (kParallel && !workers.has_value()) {
+      workers.emplace(kWorkerCount);
+    }
+
+    if (kParallel) {
+      const std::span<const int> kFrontierView(frontier);
+      workers->Run([&](unsigned worker) -> void {
+        auto& local_next = partial_next[worker];
+        if (bottom_up) {
+          const auto kBegin = static_cast<int>(
+              static_cast<long long>(kCellCount) * worker / kWorkerCount);
+          const auto kEnd = static_cast<int>(
+              static_cast<long long>(kCellCount) * (worker + 1) / kWorkerCount);
+          partial_edges[worker] = BottomUpStep<true>(
+              adjacency, distances, kBegin, kEnd, level, local_next);
+        } else {
+          const size_t kBegin = kFrontierView.size() * worker / kWorkerCount;
+          const size_t kEnd =
+              kFrontierView.size() * (worker + 1) / kWorkerCount;
+          partial_edges[worker] = TopDownStep<true>(
+              adjacency, distances,
+              kFrontierView.subspan(kBegin, kEnd - kBegin), level, local_next);
+        }
+      });
+      Concatenate(partial_next, next);
+      for (auto& edges : partial_edges) {
+        stats.edges_examined_ += edges;
+        edges = 0;
+      }
+      ++stats.parallel_levels_;
+    } else {
+      next.clear();
+      stats.edges_examined_ +=
+          bottom_up ? BottomUpStep<false>(adjacency, distances, 0, kCellCount,
+                                          level, next)
+                    : TopDownStep<false>(adjacency, distances, frontier, level,
+                                         next);
+    }
+    if (bottom_up) {
+      ++stats.bottom_up_levels_;
+    }
+    ++stats.levels_;
+
+    frontier_edges = 0;
+    for (const int kCell : next) {
+      frontier_edges += static_cast<std::uint64_t>(adjacency.Degree(kCell));
+    }
+    unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+    stats.reached_cells_ += next.size();
+    // Leave bottom-up as soon as the frontier starts shrinking again.
+    if (bottom_up && next.size() < kPreviousSize) {
+      bottom_up = false;
+    }
+    frontier.swap(next);
+  }
+
+  stats.seconds_ =
+      std::chrono::duration<double>(Clock::now() - kStartTime).count();
+  return field;
+}
+
+auto ComputeDistanceField(const MazeDomain::MazeGrid& maze_grid,
+                          GridPosition source, unsigned threads)
+    -> DistanceField {
+  return ComputeDistanceField(MazeAdjacency(maze_grid), source, threads);
+}
+
+auto FindDiameterEndpoints(const MazeAdjacency& adjacency, GridPosition seed,
+                           unsigned threads) -> DiameterEndpoints {
+  DiameterEndpoints result{.start_ = seed, .end_ = seed};
+  if (adjacency.CellCount() == 0) {
+    return result;
+  }
+  // Farthest reached cell of a field; the lowest index wins ties.
+  const auto kFarthest = [&adjacency](const DistanceField& field,
+                                      GridPosition source)
+      -> std::pair<GridPosition, std::uint32_t> {
+    int farthest = adjacency.IndexOf(source);
+    std::uint32_t distance = 0;
+    for (int index = 0; index < adjacency.CellCount(); ++index) {
+      const std::uint32_t kDistance = field.distances_[index];
+      if (kDistance != kUnreachedDistance && kDistance > distance) {
+        distance = kDistance;
+        farthest = index;
+      }
+    }
+    return {adjacency.PositionOf(farthest), distance};
+  };
+
+  const DistanceField kSeedField =
+      ComputeDistanceField(adjacency, seed, threads);
+  result.sweeps_ = 1;
+  // A connected component is a tree when it has one passage fewer than cells.
+  std::uint64_t open_sides = 0;
+  for (int index = 0; index < adjacency.CellCount(); ++index) {
+    if (kSeedField.distances_[index] != kUnreachedDistance) {
+      open_sides += static_cast<std::uint64_t>(adjacency.Degree(index));
+    }
+  }
+  result.exact_ = open_sides / 2 + 1 == kSeedField.stats_.reached_cells_;
+
+  const auto [kSeedFar, kSeedDistance] = kFarthest(kSeedField, seed);
+  result.end_ = kSeedFar;
+  result.distance_ = kSeedDistance;
+  GridPosition from = kSeedFar;
+  while (result.distance_ > 0 && result.sweeps_ < kMaxDiameterSweeps) {
+    const auto [kFar, kDistance] =
+        kFarthest(ComputeDistanceField(adjacency, from, threads), from);
+    ++result.sweeps_;
+    if (kDistance <= result.distance_) {
+      break;
+    }
+    result.start_ = from;
+    result.end_ = kFar;
+    result.distance_ = kDistance;
+    if (result.exact_) {
+      break;
+    }
+    from = kFar;
+  }
+  return result;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,77 @@
+#ifndef MAZE_DOMAIN_MAZE_DISTANCE_FIELD_H
+#define MAZE_DOMAIN_MAZE_DISTANCE_FIELD_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+inline constexpr std::uint32_t kUnreachedDistance =
+    std::numeric_limits<std::uint32_t>::max();
+
+struct DistanceFieldStats {
+  std::uint64_t edges_examined_ = 0;
+  std::uint32_t levels_ = 0;
+  std::uint32_t bottom_up_levels_ = 0;
+  std::uint32_t parallel_levels_ = 0;
+  std::uint64_t reached_cells_ = 0;
+  double seconds_ = 0.0;
+
+  auto EdgesPerSecond() const -> double {
+    return seconds_ > 0.0 ? static_cast<double>(edges_examined_) / seconds_
+                          : 0.0;
+  }
+};
+
+// BFS distance from one source to every cell, row-major, kUnreachedDistance
+// for cells the source cannot reach.
+struct DistanceField {
+  int height_ = 0;
+  int width_ = 0;
+  std::vector<std::uint32_t> distances_;
+  DistanceFieldStats stats_;
+
+  auto At(GridPosition pos) const -> std::uint32_t {
+    return distances_[(static_cast<size_t>(pos.first) * width_) + pos.second];
+  }
+};
+
+// Level-synchronous BFS. Each level runs top-down (expand the frontier) or
+// bottom-up (unreached cells look for a parent in the frontier) depending on
+// how the frontier's edge count compares with the unexplored edges. Levels
+// with a large enough frontier are split across `threads` workers with
+// per-thread next frontiers; narrow maze levels stay on the calling thread
+// where synchronisation would cost more than the work. `threads == 0` uses
+// std::thread::hardware_concurrency().
+DistanceField ComputeDistanceField(const MazeAdjacency& adjacency,
+                                   GridPosition source, unsigned threads);
+DistanceField ComputeDistanceField(const MazeDomain::MazeGrid& maze_grid,
+                                   GridPosition source, unsigned threads);
+
+// Two cells at (or near) the maze's longest shortest path: the hardest
+// start/end pair for a solver.
+struct DiameterEndpoints {
+  GridPosition start_;
+  GridPosition end_;
+  std::uint32_t distance_ = 0;
+  // True when the seed's component is a tree, where two sweeps are exact.
+  bool exact_ = false;
+  int sweeps_ = 0;
+};
+
+// Double sweep over distance fields: the farthest cell from `seed`, then the
+// farthest cell from that one. On a perfect maze this is the diameter. With
+// loops it is a lower bound, improved by further sweeps from the newest far
+// end while they keep finding longer distances (up to kMaxDiameterSweeps).
+inline constexpr int kMaxDiameterSweeps = 4;
+DiameterEndpoints FindDiameterEndpoints(const MazeAdjacency& adjacency,
+                                        GridPosition seed, unsigned threads);
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_DISTANCE_FIELD_H
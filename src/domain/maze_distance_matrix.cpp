@@ -0,0 +1,325 @@
+#include "domain/maze_distance_matrix.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using SourceMask = std::uint64_t;
+
+constexpr int kNoTarget = -1;
+
+// Source bits of one cell: those whose wave has passed it, and those
+// arriving on the next level, double-buffered by level parity so a level can
+// collect and expand each of its cells in one visit.
+struct CellWaves {
+  SourceMask seen;
+  std::array<SourceMask, 2> next;
+};
+
+// Per-worker pass state, indexed by MazeAdjacency cell. next words are
+// cleared as they are collected, so only seen needs a reset between passes.
+struct PassState {
+  std::vector<CellWaves> cells_;
+  std::vector<int> frontier_;
+  std::vector<int> upcoming_;
+};
+
+// A source's wave enters the pass on `level`; its distances are counted
+// from there.
+struct Start {
+  std::uint32_t level;
+  int cell;
+  int bit;
+};
+
+class MatrixBuilder {
+ public:
+  MatrixBuilder(const MazeAdjacency& adjacency,
+                std::span<const GridPosition> sources,
+                std::span<const GridPosition> targets, DistanceMatrix& matrix)
+      : adjacency_(adjacency),
+        neighbors_(adjacency, {0, 1, 2, 3}),
+        sources_(sources),
+        target_cells_((static_cast<size_t>(adjacency.CellCount()) +
+                       kWordBits - 1) /
+                          kWordBits,
+                      0),
+        first_target_(static_cast<size_t>(adjacency.CellCount()), kNoTarget),
+        next_target_(targets.size(), kNoTarget),
+        matrix_(matrix) {
+    // Chained in reverse so every chain runs in target order.
+    for (size_t target = targets.size(); target-- > 0;) {
+      if (Inside(targets[target])) {
+        const int kCell = adjacency.IndexOf(targets[target]);
+        target_cells_[static_cast<size_t>(kCell) / kWordBits] |=
+            std::uint64_t{1} << (static_cast<size_t>(kCell) % kWordBits);
+        next_target_[target] = first_target_[kCell];
+        first_target_[kCell] = static_cast<int>(target);
+        ++reachable_targets_;
+      }
+    }
+    // Waves of nearby sources overlap for longer, so passes take sources in
+    // Z-order rather than input order.
+    source_order_.resize(sources.size());
+    std::iota(source_order_.begin(), source_order_.end(), size_t{0});
+    constexpr auto kLast = std::numeric_limits<std::uint64_t>::max();
+    std::ranges::stable_sort(source_order_, {}, [&](size_t source) {
+      return Inside(sources[source]) ? MortonCode(sources[source]) : kLast;
+    });
+  }
+
+  auto PassCount() const -> size_t {
+    return (sources_.size() + kSourcesPerPass - 1) / kSourcesPerPass;
+  }
+
+  // The pass's sources are bits 0..63 of every mask.
+  void RunPass(size_t pass, PassState& state,
+               DistanceMatrixStats& stats) const {
+    const auto kCellCount = static_cast<size_t>(adjacency_.CellCount());
+    if (state.cells_.size() != kCellCount) {
+      state.cells_.assign(kCellCount, {});
+    } else {
+      for (CellWaves& waves : state.cells_) {
+        waves.seen = 0;
+      }
+    }
+    state.frontier_.clear();
+    state.upcoming_.clear();
+
+    const size_t kFirst = pass * kSourcesPerPass;
+    const std::span<const size_t> kPassSources =
+        std::span(source_order_)
+            .subspan(kFirst, std::min(kSourcesPerPass,
+                                      source_order_.size() - kFirst));
+    const std::vector<Start> kStarts = StaggeredStarts(kPassSources);
+    std::array<std::uint32_t, kSourcesPerPass> start_levels{};
+    for (const Start& start : kStarts) {
+      start_levels[start.bit] = start.level;
+    }
+    std::uint64_t unresolved = kStarts.size() * reachable_targets_;
+    ++stats.passes_;
+
+    size_t next_start = 0;
+    std::uint32_t level = 0;
+    while (unresolved > 0) {
+      if (state.frontier_.empty()) {
+        if (next_start == kStarts.size()) {
+          break;
+        }
+        level = kStarts[next_start].level;
+      }
+      const size_t kCurrent = level & 1U;
+      for (; next_start < kStarts.size() &&
+             kStarts[next_start].level == level;
+           ++next_start) {
+        const Start& start = kStarts[next_start];
+        if (state.cells_[start.cell].next[kCurrent] == 0) {
+          state.frontier_.push_back(start.cell);
+        }
+        state.cells_[start.cell].next[kCurrent] |= SourceMask{1} << start.bit;
+      }
+      for (const int kCell : state.frontier_) {
+        CellWaves& waves = state.cells_[kCell];
+        // A wave can be sent here on the level it arrives by another route.
+        const SourceMask kArrived = waves.next[kCurrent] & ~waves.seen;
+        waves.next[kCurrent] = 0;
+        if (kArrived == 0) {
+          continue;
+        }
+        waves.seen |= kArrived;
+        ++stats.cell_expansions_;
+        if (IsTarget(kCell)) {
+          unresolved -= Record(kCell, kArrived, kPassSources, start_levels,
+                               level);
+        }
+        for (const int kOffset : neighbors_.Of(kCell)) {
+          CellWaves& neighbor = state.cells_[kCell + kOffset];
+          const SourceMask kArriving = kArrived & ~neighbor.seen;
+          if (kArriving == 0) {
+            continue;
+          }
+          if (neighbor.next[kCurrent ^ 1U] == 0) {
+            state.upcoming_.push_back(kCell + kOffset);
+          }
+          neighbor.next[kCurrent ^ 1U] |= kArriving;
+        }
+      }
+      ++stats.levels_;
+      ++level;
+      state.frontier_.swap(state.upcoming_);
+      state.upcoming_.clear();
+    }
+    // An early stop leaves next words behind.
+    for (const int kCell : state.frontier_) {
+      state.cells_[kCell].next = {};
+    }
+  }
+
+ private:
+  static constexpr size_t kWordBits = 64;
+
+  auto Inside(GridPosition pos) const -> bool {
+    return pos.first >= 0 && pos.first < adjacency_.Height() &&
+           pos.second >= 0 && pos.second < adjacency_.Width();
+  }
+  auto IsTarget(int cell) const -> bool {
+    return ((target_cells_[static_cast<size_t>(cell) / kWordBits] >>
+             (static_cast<size_t>(cell) % kWordBits)) &
+            1U) != 0;
+  }
+
+  // Interleaves row and column bits.
+  static auto MortonCode(GridPosition pos) -> std::uint64_t {
+    std::uint64_t code = 0;
+    for (int bit = 0; bit < 32; ++bit) {
+      code |= ((static_cast<std::uint64_t>(pos.first) >> bit) & 1U)
+              << (2 * bit + 1);
+      code |= ((static_cast<std::uint64_t>(pos.second) >> bit) & 1U)
+              << (2 * bit);
+    }
+    return code;
+  }
+
+  // Waves started together only meet where two sources are equally far, which
+  // in a maze is almost nowhere. Delaying each source by how much closer it is
+  // to a hub than the farthest one makes every wave reach the hub at once, and
+  // from there on they travel as one word wherever the hub lies on their
+  // shortest paths. Sorted by level; sources outside the maze are left out.
+  auto StaggeredStarts(std::span<const size_t> pass_sources) const
+      -> std::vector<Start> {
+    std::vector<Start> starts;
+    for (size_t bit = 0; bit < pass_sources.size(); ++bit) {
+      const GridPosition kSource = sources_[pass_sources[bit]];
+      if (Inside(kSource)) {
+        starts.push_back({.level = 0,
+                          .cell = adjacency_.IndexOf(kSource),
+                          .bit = static_cast<int>(bit)});
+      }
+    }
+    if (starts.size() < 2) {
+      return starts;
+    }
+    const DistanceField kHub = ComputeDistanceField(
+        adjacency_, adjacency_.PositionOf(starts[starts.size() / 2].cell), 1);
+    std::uint32_t farthest = 0;
+    for (const Start& start : starts) {
+      if (kHub.distances_[start.cell] != kUnreachedDistance) {
+        farthest = std::max(farthest, kHub.distances_[start.cell]);
+      }
+    }
+    for (Start& start : starts) {
+      if (kHub.distances_[start.cell] != kUnreachedDistance) {
+        start.level = farthest - kHub.distances_[start.cell];
+      }
+    }
+    std::ranges::stable_sort(starts, {}, &Start::level);
+    return starts;
+  }
+
+  // Writes the distance of every source in `arrived` to the targets on
+  // `cell`; returns the number of entries written.
+  auto Record(int cell, SourceMask arrived,
+              std::span<const size_t> pass_sources,
+              const std::array<std::uint32_t, kSourcesPerPass>& start_levels,
+              std::uint32_t level) const -> std::uint64_t {
+    std::uint64_t written = 0;
+    const size_t kTargetCount = matrix_.target_count_;
+    while (arrived != 0) {
+      const int kBit = std::countr_zero(arrived);
+      arrived &= arrived - 1;
+      const size_t kSource = pass_sources[kBit];
+      for (int target = first_target_[cell]; target != kNoTarget;
+           target = next_target_[target]) {
+        matrix_.distances_[(kSource * kTargetCount) + target] =
+            level - start_levels[kBit];
+        ++written;
+      }
+    }
+    return written;
+  }
+
+  const MazeAdjacency& adjacency_;
+  const NeighborTable neighbors_;
+  std::span<const GridPosition> sources_;
+  std::vector<size_t> source_order_;
+  // Cells holding a target, and the targets on each cell chained through
+  // next_target_ (several targets may share a cell).
+  std::vector<std::uint64_t> target_cells_;
+  std::vector<int> first_target_;
+  std::vector<int> next_target_;
+  std::uint64_t reachable_targets_ = 0;
+  DistanceMatrix& matrix_;
+};
+
+}  // namespace
+
+auto ComputeDistanceMatrix(const MazeAdjacency& adjacency,
+                           std::span<const GridPosition> sources,
+                           std::span<const GridPosition> targets,
+                           unsigned threads) -> DistanceMatrix {
+  const auto kStartTime = Clock::now();
+  DistanceMatrix matrix;
+  matrix.source_count_ = sources.size();
+  matrix.target_count_ = targets.size();
+  matrix.distances_.assign(sources.size() * targets.size(),
+                           kUnreachedDistance);
+  if (matrix.distances_.empty() || adjacency.CellCount() == 0) {
+    return matrix;
+  }
+
+  const MatrixBuilder kBuilder(adjacency, sources, targets, matrix);
+  const size_t kPassCount = kBuilder.PassCount();
+  const size_t kWorkerCount = std::min<size_t>(
+      kPassCount,
+      threads == 0 ? std::max(1U, std::thread::hardware_concurrency())
+                   : threads);
+  std::vector<DistanceMatrixStats> partial_stats(kWorkerCount);
+  std::atomic<size_t> next_pass{0};
+  const auto kWorker = [&](size_t worker) -> void {
+    PassState state;
+    while (true) {
+      const size_t kPass = next_pass.fetch_add(1, std::memory_order_relaxed);
+      if (kPass >= kPassCount) {
+        return;
+      }
+      kBuilder.RunPass(kPass, state, partial_stats[worker]);
+    }
+  };
+
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(kWorkerCount - 1);
+    for (size_t worker = 1; worker < kWorkerCount; ++worker) {
+      pool.emplace_back(kWorker, worker);
+    }
+    kWorker(0);
+  }
+  for (const DistanceMatrixStats& part : partial_stats) {
+    matrix.stats_.passes_ += part.passes_;
+    matrix.stats_.levels_ += part.levels_;
+    matrix.stats_.cell_expansions_ += part.cell_expansions_;
+  }
+  matrix.stats_.seconds_ =
+      std::chrono::duration<double>(Clock::now() - kStartTime).count();
+  return matrix;
+}
+
+auto ComputeDistanceMatrix(const MazeDomain::MazeGrid& maze_grid,
+                           std::span<const GridPosition> sources,
+                           std::span<const GridPosition> targets,
+                           unsigned threads) -> DistanceMatrix {
+  return ComputeDistanceMatrix(MazeAdjacency(maze_grid), sources, targets,
+                               threads);
+}
+
+}  // namespace MazeSolverDomain
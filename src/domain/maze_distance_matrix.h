@@ -0,0 +1,61 @@
+#ifndef MAZE_DOMAIN_MAZE_DISTANCE_MATRIX_H
+#define MAZE_DOMAIN_MAZE_DISTANCE_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_distance_field.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Sources tracked by one pass: one bit of a 64-bit word per source.
+inline constexpr size_t kSourcesPerPass = 64;
+
+struct DistanceMatrixStats {
+  std::uint32_t passes_ = 0;
+  // BFS levels summed over the passes.
+  std::uint64_t levels_ = 0;
+  // Frontier cells expanded, each once per level for all its sources.
+  std::uint64_t cell_expansions_ = 0;
+  double seconds_ = 0.0;
+};
+
+// BFS distance from every source to every target, source-major;
+// kUnreachedDistance where the target cannot be reached (or either cell is
+// outside the maze).
+struct DistanceMatrix {
+  size_t source_count_ = 0;
+  size_t target_count_ = 0;
+  std::vector<std::uint32_t> distances_;
+  DistanceMatrixStats stats_;
+
+  auto At(size_t source, size_t target) const -> std::uint32_t {
+    return distances_[(source * target_count_) + target];
+  }
+};
+
+// Bit-parallel multi-source BFS. Sources are taken kSourcesPerPass at a time;
+// every cell carries a "seen" and a "frontier" word with one bit per source,
+// and a level ORs each frontier word into the open neighbours' next words,
+// masked by what they have already seen. One expansion advances every source
+// whose wave is at that cell on that level, so overlapping waves cost one
+// BFS instead of one each. A pass ends once all of its sources have reached
+// every target. Passes are independent and are spread over `threads` workers
+// (0 = std::thread::hardware_concurrency()).
+DistanceMatrix ComputeDistanceMatrix(const MazeAdjacency& adjacency,
+                                     std::span<const GridPosition> sources,
+                                     std::span<const GridPosition> targets,
+                                     unsigned threads);
+DistanceMatrix ComputeDistanceMatrix(const MazeDomain::MazeGrid& maze_grid,
+                                     std::span<const GridPosition> sources,
+                                     std::span<const GridPosition> targets,
+                                     unsigned threads);
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_DISTANCE_MATRIX_H
@@ -0,0 +1,101 @@
+#include "domain/maze_flow_field.h"
+
+#include <bit>
+#include <chrono>
+
+namespace MazeSolverDomain {
+
+auto BuildFlowField(const MazeAdjacency& adjacency, GridPosition goal)
+    -> FlowField {
+  const auto kStartTime = std::chrono::steady_clock::now();
+  FlowField field;
+  field.height_ = adjacency.Height();
+  field.width_ = adjacency.Width();
+  field.goal_ = goal;
+  const auto kCellCount = static_cast<size_t>(adjacency.CellCount());
+  field.directions_.assign(
+      (kCellCount + FlowField::kCellsPerWord - 1) / FlowField::kCellsPerWord,
+      0);
+  field.reached_.assign((kCellCount + 63) / 64, 0);
+  if (!field.Contains(goal)) {
+    return field;
+  }
+
+  const auto kMark = [&field](int cell) -> void {
+    field.reached_[static_cast<size_t>(cell) / 64] |=
+        std::uint64_t{1} << (static_cast<size_t>(cell) % 64);
+  };
+  const auto kIsReached = [&field](int cell) -> bool {
+    return ((field.reached_[static_cast<size_t>(cell) / 64] >>
+             (static_cast<size_t>(cell) % 64)) &
+            1U) != 0;
+  };
+
+  // The queue is every reached cell in BFS order, so it never outgrows the
+  // grid and needs no pops.
+  std::vector<int> queue;
+  queue.reserve(kCellCount);
+  queue.push_back(adjacency.IndexOf(goal));
+  kMark(queue.front());
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const int kCell = queue[head];
+    unsigned mask = adjacency.OpenMask(kCell);
+    while (mask != 0) {
+      const int kDir = std::countr_zero(mask);
+      mask &= mask - 1;
+      const int kNeighbor = adjacency.Neighbor(kCell, kDir);
+      if (kIsReached(kNeighbor)) {
+        continue;
+      }
+      kMark(kNeighbor);
+      const auto kIndex = static_cast<size_t>(kNeighbor);
+      field.directions_[kIndex / FlowField::kCellsPerWord] |=
+          static_cast<std::uint64_t>(MazeAdjacency::Opposite(kDir))
+          << (2 * (kIndex % FlowField::kCellsPerWord));
+      queue.push_back(kNeighbor);
+    }
+  }
+  field.stats_.reached_cells_ = queue.size();
+  field.stats_.seconds_ = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - kStartTime)
+                              .count();
+  return field;
+}
+
+auto BuildFlowField(const MazeDomain::MazeGrid& maze_grid, GridPosition goal)
+    -> FlowField {
+  return BuildFlowField(MazeAdjacency(maze_grid), goal);
+}
+
+auto FollowFlowField(const FlowField& field, GridPosition start)
+    -> std::vector<GridPosition> {
+  std::vector<GridPosition> path;
+  if (!field.Reaches(start)) {
+    return path;
+  }
+  const auto kWidth = static_cast<size_t>(field.width_);
+  const size_t kGoal =
+      (static_cast<size_t>(field.goal_.first) * kWidth) + field.goal_.second;
+  GridPosition pos = start;
+  size_t cell = (static_cast<size_t>(pos.first) * kWidth) + pos.second;
+  path.push_back(pos);
+  while (cell != kGoal) {
+    const auto kDir = static_cast<int>(
+        (field.directions_[cell / FlowField::kCellsPerWord] >>
+         (2 * (cell % FlowField::kCellsPerWord))) &
+        3U);
+    pos.first += MazeAdjacency::kRowDelta[kDir];
+    pos.second += MazeAdjacency::kColDelta[kDir];
+    // Only a damaged field, e.g. from a corrupt file, leaves the reached
+    // cells or runs longer than it has cells.
+    if (!field.Reaches(pos) || path.size() >= field.stats_.reached_cells_) {
+      path.clear();
+      return path;
+    }
+    cell = (static_cast<size_t>(pos.first) * kWidth) + pos.second;
+    path.push_back(pos);
+  }
+  return path;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,83 @@
+#ifndef MAZE_DOMAIN_MAZE_FLOW_FIELD_H
+#define MAZE_DOMAIN_MAZE_FLOW_FIELD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+struct FlowFieldStats {
+  std::uint64_t reached_cells_ = 0;
+  double seconds_ = 0.0;
+};
+
+// First step of a shortest path to one goal from every cell, as a
+// MazeAdjacency direction packed two bits per cell (32 cells per word,
+// row-major). reached_ holds one bit per cell; the direction of an unreached
+// cell, and of the goal itself, means nothing.
+struct FlowField {
+  static constexpr size_t kCellsPerWord = 32;
+
+  int height_ = 0;
+  int width_ = 0;
+  GridPosition goal_ = {0, 0};
+  std::vector<std::uint64_t> directions_;
+  std::vector<std::uint64_t> reached_;
+  FlowFieldStats stats_;
+
+  auto Contains(GridPosition pos) const -> bool {
+    return pos.first >= 0 && pos.first < height_ && pos.second >= 0 &&
+           pos.second < width_;
+  }
+  // False outside the grid too.
+  auto Reaches(GridPosition pos) const -> bool {
+    if (!Contains(pos)) {
+      return false;
+    }
+    const size_t kCell = CellOf(pos);
+    return ((reached_[kCell / 64] >> (kCell % 64)) & 1U) != 0;
+  }
+  auto Direction(GridPosition pos) const -> int {
+    const size_t kCell = CellOf(pos);
+    return static_cast<int>(
+        (directions_[kCell / kCellsPerWord] >> (2 * (kCell % kCellsPerWord))) &
+        3U);
+  }
+  // The neighbour one step closer to the goal; `pos` must be reached.
+  auto NextStep(GridPosition pos) const -> GridPosition {
+    const int kDir = Direction(pos);
+    return {pos.first + MazeAdjacency::kRowDelta[kDir],
+            pos.second + MazeAdjacency::kColDelta[kDir]};
+  }
+  auto Bytes() const -> size_t {
+    return (directions_.size() + reached_.size()) * sizeof(std::uint64_t);
+  }
+
+ private:
+  auto CellOf(GridPosition pos) const -> size_t {
+    return (static_cast<size_t>(pos.first) * static_cast<size_t>(width_)) +
+           static_cast<size_t>(pos.second);
+  }
+};
+
+// One BFS from `goal` over the reversed passages (the same ones, mazes being
+// undirected); every cell points back along the edge it was reached through.
+// An out of bounds goal leaves every cell unreached.
+FlowField BuildFlowField(const MazeAdjacency& adjacency, GridPosition goal);
+FlowField BuildFlowField(const MazeDomain::MazeGrid& maze_grid,
+                         GridPosition goal);
+
+// Follows the field from `start`: start -> goal, a shortest path, in
+// O(path length) with no search. Empty when the goal is not reachable, or
+// the field does not lead there.
+std::vector<GridPosition> FollowFlowField(const FlowField& field,
+                                          GridPosition start);
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_FLOW_FIELD_H
@@ -146,27 +146,44 @@ void DivideRegion(Grid& maze_grid, int row_start, int row_end, int col_start,
   }
 }
 
-void GenerateMazeRecursiveInternal(int row, int col, Grid& current_maze_data,
-                                   std::vector<std::vector<bool>>& visited,
-                                   int width, int height) {
-  visited[row][col] = true;
-  std::vector<Direction> directions = {Direction::Up, Direction::Right,
-                                       Direction::Down, Direction::Left};
-
-  std::random_device random_device;
-  std::mt19937 engine(random_device());
-  std::shuffle(directions.begin(), directions.end(), engine);
-
-  for (Direction dir : directions) {
-    const auto kInfo = kDirectionTable[DirectionIndex(dir)];
-    int next_row = row + kInfo.dr;
-    int next_col = col + kInfo.dc;
-
-    if (next_row >= 0 && next_row < height && next_col >= 0 &&
-        next_col < width && !visited[next_row][next_col]) {
-      Carve(current_maze_data, row, col, dir);
-      GenerateMazeRecursiveInternal(next_row, next_col, current_maze_data,
-                                    visited, width, height);
+// Randomized depth-first backtracker. The path being carved lives on an
+// explicit stack rather than the call stack, which a recursion per cell
+// overflows on mazes of a few thousand cells.
+void GenerateMazeDfsInternal(int start_row, int start_col,
+                             Grid& current_maze_data,
+                             std::vector<std::vector<bool>>& visited,
+                             int width, int height, std::mt19937& engine) {
+  struct Frame {
+    int row;
+    int col;
+    std::array<Direction, 4> directions;
+    size_t next;
+  };
+
+  const auto kVisit = [&visited, &engine](int row, int col) -> Frame {
+    visited[row][col] = true;
+    Frame frame{
+        .row = row, .col = col, .directions = kAllDirections, .next = 0};
+    std::shuffle(frame.directions.begin(), frame.directions.end(), engine);
+    return frame;
+  };
+
+  std::vector<Frame> stack;
+  stack.push_back(kVisit(start_row, start_col));
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+    if (frame.next == frame.directions.size()) {
+      stack.pop_back();
+      continue;
+    }
+    const Direction kDir = frame.directions[frame.next++];
+    const auto kInfo = kDirectionTable[DirectionIndex(kDir)];
+    const int kNextRow = frame.row + kInfo.dr;
+    const int kNextCol = frame.col + kInfo.dc;
+    if (kNextRow >= 0 && kNextRow < height && kNextCol >= 0 &&
+        kNextCol < width && !visited[kNextRow][kNextCol]) {
+      Carve(current_maze_data, frame.row, frame.col, kDir);
+      stack.push_back(kVisit(kNextRow, kNextCol));
     }
   }
 }
@@ -180,7 +197,8 @@ struct FrontierEdge {
 };
 
 void GenerateMazePrimsInternal(int start_row, int start_col,
-                               Grid& current_maze_data, int width, int height) {
+                               Grid& current_maze_data, int width, int height,
+                               std::mt19937& engine) {
   const GridSize kGridSize{.width = width, .height = height};
   auto visited = CreateVisitedGrid(kGridSize);
   for (int row_index = 0; row_index < height; ++row_index) {
@@ -191,9 +209,6 @@ void GenerateMazePrimsInternal(int start_row, int start_col,
     }
   }
 
-  std::random_device random_device;
-  std::mt19937 engine(random_device());
-
   visited[start_row][start_col] = true;
   std::vector<FrontierEdge> frontier_walls;
 
@@ -278,7 +293,7 @@ class DSU {
 };
 
 void GenerateMazeKruskalInternal(Grid& current_maze_data, int width,
-                                 int height) {
+                                 int height, std::mt19937& engine) {
   for (int row_index = 0; row_index < height; ++row_index) {
     for (int col_index = 0; col_index < width; ++col_index) {
       for (bool& wall : current_maze_data[row_index][col_index].walls) {
@@ -299,8 +314,6 @@ void GenerateMazeKruskalInternal(Grid& current_maze_data, int width,
     }
   }
 
-  std::random_device random_device;
-  std::mt19937 engine(random_device());
   std::shuffle(all_walls.begin(), all_walls.end(), engine);
 
   DSU dsu(width * height);
@@ -325,46 +338,42 @@ void GenerateMazeKruskalInternal(Grid& current_maze_data, int width,
 }
 
 void GenerateMazeDfs(Grid& maze, int start_row, int start_col, int width,
-                     int height) {
+                     int height, std::mt19937& engine) {
   const GridSize kGridSize{.width = width, .height = height};
   auto visited = CreateVisitedGrid(kGridSize);
-  GenerateMazeRecursiveInternal(start_row, start_col, maze, visited, width,
-                                height);
+  GenerateMazeDfsInternal(start_row, start_col, maze, visited, width, height,
+                          engine);
 }
 
 void GenerateMazePrims(Grid& maze, int start_row, int start_col, int width,
-                       int height) {
-  GenerateMazePrimsInternal(start_row, start_col, maze, width, height);
+                       int height, std::mt19937& engine) {
+  GenerateMazePrimsInternal(start_row, start_col, maze, width, height, engine);
 }
 
 void GenerateMazeKruskal(Grid& maze, int /*start_row*/, int /*start_col*/,
-                         int width, int height) {
-  GenerateMazeKruskalInternal(maze, width, height);
+                         int width, int height, std::mt19937& engine) {
+  GenerateMazeKruskalInternal(maze, width, height, engine);
 }
 
 void GenerateMazeRecursiveDivision(Grid& maze, int /*start_row*/,
-                                   int /*start_col*/, int width, int height) {
+                                   int /*start_col*/, int width, int height,
+                                   std::mt19937& engine) {
   if (width < kMinDivisionSpan || height < kMinDivisionSpan) {
     ResetWallsForDivision(maze, width, height);
     return;
   }
   ResetWallsForDivision(maze, width, height);
-  std::random_device random_device;
-  std::mt19937 engine(random_device());
   DivideRegion(maze, 0, height - 1, 0, width - 1, engine);
 }
 
 void GenerateMazeGrowingTree(Grid& maze, int start_row, int start_col, int width,
-                             int height) {
+                             int height, std::mt19937& engine) {
   const GridSize kGridSize{.width = width, .height = height};
   auto visited = CreateVisitedGrid(kGridSize);
   std::vector<CellPosition> active_cells;
   active_cells.push_back({start_row, start_col});
   visited[start_row][start_col] = true;
 
-  std::random_device random_device;
-  std::mt19937 engine(random_device());
-
   while (!active_cells.empty()) {
     std::uniform_int_distribution<int> index_dist(
         0, static_cast<int>(active_cells.size()) - 1);
@@ -485,6 +494,16 @@ auto MazeGeneratorFactory::names() const -> std::vector<std::string> {
 void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
                              int start_c, int grid_width, int grid_height,
                              MazeAlgorithmType algorithm_type) {
+  std::random_device random_device;
+  std::mt19937 engine(random_device());
+  generate_maze_structure(maze_grid_to_populate, start_r, start_c, grid_width,
+                          grid_height, algorithm_type, engine);
+}
+
+void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
+                             int start_c, int grid_width, int grid_height,
+                             MazeAlgorithmType algorithm_type,
+                             std::mt19937& engine) {
   if (algorithm_type == MazeAlgorithmType::DFS ||
       algorithm_type == MazeAlgorithmType::PRIMS ||
       algorithm_type == MazeAlgorithmType::GROWING_TREE) {
@@ -510,7 +529,8 @@ void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
         MazeGeneratorFactory::instance().get_generator(MazeAlgorithmType::DFS);
   }
   if (generator) {
-    generator(maze_grid_to_populate, start_r, start_c, grid_width, grid_height);
+    generator(maze_grid_to_populate, start_r, start_c, grid_width, grid_height,
+              engine);
   }
 }
 
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <map>
+#include <random>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -24,8 +25,9 @@ enum class Direction { Up = 0, Right = 1, Down = 2, Left = 3 };
 
 class MazeGeneratorFactory {
  public:
-  using Generator = std::function<void(MazeGrid&, int start_r, int start_c,
-                                       int grid_width, int grid_height)>;
+  using Generator =
+      std::function<void(MazeGrid&, int start_r, int start_c, int grid_width,
+                         int grid_height, std::mt19937& engine)>;
 
   static MazeGeneratorFactory& instance();
 
@@ -49,9 +51,16 @@ class MazeGeneratorFactory {
 };
 
 // Pure domain behavior: generates maze structure into the provided grid.
+// Draws from a freshly seeded engine on every call.
 void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
                              int start_c, int grid_width, int grid_height,
                              MazeAlgorithmType algorithm_type);
+// Same, drawing every random choice from `engine`, so equal engine states
+// produce equal mazes.
+void generate_maze_structure(MazeGrid& maze_grid_to_populate, int start_r,
+                             int start_c, int grid_width, int grid_height,
+                             MazeAlgorithmType algorithm_type,
+                             std::mt19937& engine);
 
 // Factory-backed metadata helpers.
 std::string algorithm_name(MazeAlgorithmType algorithm_type);
@@ -0,0 +1,42 @@
+#ifndef MAZE_DOMAIN_MAZE_GRID_ACCESS_H
+#define MAZE_DOMAIN_MAZE_GRID_ACCESS_H
+
+#include <concepts>
+
+#include "domain/maze_grid.h"
+
+namespace MazeSolverDomain {
+
+// Minimal read access the memoryless solvers need: the grid size and one wall
+// bit at a time. Anything from an in-memory MazeGrid to a memory-mapped file
+// can satisfy it without materialising the whole maze.
+template <typename Grid>
+concept WallGridAccess = requires(const Grid& grid, int row, int col,
+                                  int wall) {
+  { grid.Height() } -> std::convertible_to<int>;
+  { grid.Width() } -> std::convertible_to<int>;
+  { grid.HasWall(row, col, wall) } -> std::convertible_to<bool>;
+};
+
+// WallGridAccess over a MazeGrid that lives in memory.
+class InMemoryGridAccess {
+ public:
+  explicit InMemoryGridAccess(const MazeDomain::MazeGrid& maze_grid)
+      : maze_grid_(maze_grid) {}
+
+  auto Height() const -> int { return static_cast<int>(maze_grid_.size()); }
+  auto Width() const -> int {
+    return maze_grid_.empty() ? 0
+                              : static_cast<int>(maze_grid_.front().size());
+  }
+  auto HasWall(int row, int col, int wall) const -> bool {
+    return maze_grid_[row][col].walls[wall];
+  }
+
+ private:
+  const MazeDomain::MazeGrid& maze_grid_;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_GRID_ACCESS_H
@@ -0,0 +1,208 @@
+#include "domain/maze_incremental_planner.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr int kNoCell = -1;
+// Leaves headroom so "infinity + 1" and "infinity + h" never wrap.
+constexpr std::uint32_t kInfinity =
+    std::numeric_limits<std::uint32_t>::max() / 4;
+constexpr int kWallCount = MazeDomain::kWallCount;
+constexpr std::array<int, kWallCount> kRowDelta = {-1, 0, 1, 0};
+constexpr std::array<int, kWallCount> kColDelta = {0, 1, 0, -1};
+
+constexpr auto OppositeWall(int wall) -> int {
+  return (wall + 2) % kWallCount;
+}
+
+}  // namespace
+
+IncrementalPlanner::IncrementalPlanner(MazeDomain::MazeGrid maze_grid,
+                                       GridPosition start_node,
+                                       GridPosition end_node)
+    : maze_grid_(std::move(maze_grid)) {
+  height_ = static_cast<int>(maze_grid_.size());
+  width_ =
+      maze_grid_.empty() ? 0 : static_cast<int>(maze_grid_.front().size());
+  if (!IsValidCell(start_node) || !IsValidCell(end_node)) {
+    return;
+  }
+  start_ = IndexOf(start_node);
+  end_ = IndexOf(end_node);
+  const auto kCellCount =
+      static_cast<size_t>(height_) * static_cast<size_t>(width_);
+  g_.assign(kCellCount, kInfinity);
+  rhs_.assign(kCellCount, kInfinity);
+  rhs_[start_] = 0;
+  PushCell(start_);
+}
+
+auto IncrementalPlanner::IsValidCell(GridPosition pos) const -> bool {
+  return pos.first >= 0 && pos.first < height_ && pos.second >= 0 &&
+         pos.second < width_;
+}
+
+auto IncrementalPlanner::IsOpen(int cell, int wall) const -> bool {
+  const GridPosition kPos = PositionOf(cell);
+  const GridPosition kNext = {kPos.first + kRowDelta[wall],
+                              kPos.second + kColDelta[wall]};
+  return IsValidCell(kNext) &&
+         !maze_grid_[kPos.first][kPos.second].walls[wall];
+}
+
+auto IncrementalPlanner::Neighbor(int cell, int wall) const -> int {
+  return cell + (kRowDelta[wall] * width_) + kColDelta[wall];
+}
+
+auto IncrementalPlanner::Heuristic(int cell) const -> std::uint32_t {
+  const GridPosition kPos = PositionOf(cell);
+  const GridPosition kEnd = PositionOf(end_);
+  return static_cast<std::uint32_t>(std::abs(kPos.first - kEnd.first) +
+                                    std::abs(kPos.second - kEnd.second));
+}
+
+auto IncrementalPlanner::CalculateKey(int cell) const -> Key {
+  const std::uint32_t kBest = std::min(g_[cell], rhs_[cell]);
+  return {.primary = kBest + Heuristic(cell), .secondary = kBest};
+}
+
+void IncrementalPlanner::PushCell(int cell) {
+  queue_.push_back({.key = CalculateKey(cell), .cell = cell});
+  std::ranges::push_heap(queue_, std::ranges::greater{}, &QueueEntry::key);
+}
+
+// Entries are never removed in place: a cell is re-pushed whenever its key
+// changes, and older copies are skipped when they reach the top.
+auto IncrementalPlanner::IsStale(const QueueEntry& entry) const -> bool {
+  return g_[entry.cell] == rhs_[entry.cell] ||
+         entry.key != CalculateKey(entry.cell);
+}
+
+void IncrementalPlanner::DropStaleEntries() {
+  while (!queue_.empty() && IsStale(queue_.front())) {
+    std::ranges::pop_heap(queue_, std::ranges::greater{}, &QueueEntry::key);
+    queue_.pop_back();
+  }
+}
+
+void IncrementalPlanner::UpdateCell(int cell) {
+  if (cell != start_) {
+    std::uint32_t best = kInfinity;
+    for (int wall = 0; wall < kWallCount; ++wall) {
+      if (IsOpen(cell, wall)) {
+        best = std::min(best, g_[Neighbor(cell, wall)] + 1);
+      }
+    }
+    rhs_[cell] = std::min(best, kInfinity);
+    ++pending_updates_;
+  }
+  if (g_[cell] != rhs_[cell]) {
+    PushCell(cell);
+  }
+}
+
+auto IncrementalPlanner::Plan() -> bool {
+  stats_.expanded_ = 0;
+  if (start_ == kNoCell) {
+    return false;
+  }
+
+  while (true) {
+    DropStaleEntries();
+    if (queue_.empty()) {
+      break;
+    }
+    const bool kEndSettled = g_[end_] == rhs_[end_];
+    if (kEndSettled && !(queue_.front().key < CalculateKey(end_))) {
+      break;
+    }
+
+    const int kCell = queue_.front().cell;
+    std::ranges::pop_heap(queue_, std::ranges::greater{}, &QueueEntry::key);
+    queue_.pop_back();
+    ++stats_.expanded_;
+
+    if (g_[kCell] > rhs_[kCell]) {
+      g_[kCell] = rhs_[kCell];
+    } else {
+      g_[kCell] = kInfinity;
+      UpdateCell(kCell);
+    }
+    for (int wall = 0; wall < kWallCount; ++wall) {
+      if (IsOpen(kCell, wall)) {
+        UpdateCell(Neighbor(kCell, wall));
+      }
+    }
+  }
+
+  stats_.total_expanded_ += stats_.expanded_;
+  stats_.updated_ = pending_updates_;
+  pending_updates_ = 0;
+  return g_[end_] < kInfinity;
+}
+
+auto IncrementalPlanner::Path() const -> std::vector<GridPosition> {
+  std::vector<GridPosition> path;
+  if (start_ == kNoCell || g_[end_] >= kInfinity) {
+    return path;
+  }
+  // Walk back along strictly decreasing g-values.
+  int cell = end_;
+  path.push_back(PositionOf(cell));
+  while (cell != start_) {
+    int previous = kNoCell;
+    for (int wall = 0; wall < kWallCount; ++wall) {
+      if (!IsOpen(cell, wall)) {
+        continue;
+      }
+      const int kNext = Neighbor(cell, wall);
+      if (g_[kNext] + 1 == g_[cell]) {
+        previous = kNext;
+        break;
+      }
+    }
+    if (previous == kNoCell) {
+      return {};
+    }
+    cell = previous;
+    path.push_back(PositionOf(cell));
+  }
+  std::ranges::reverse(path);
+  return path;
+}
+
+auto IncrementalPlanner::ApplyWallToggles(std::span<const WallToggle> toggles)
+    -> size_t {
+  size_t applied = 0;
+  for (const auto& toggle : toggles) {
+    if (toggle.wall < 0 || toggle.wall >= kWallCount ||
+        !IsValidCell(toggle.cell)) {
+      continue;
+    }
+    const GridPosition kOther = {toggle.cell.first + kRowDelta[toggle.wall],
+                                 toggle.cell.second + kColDelta[toggle.wall]};
+    if (!IsValidCell(kOther)) {
+      continue;
+    }
+    auto& wall = maze_grid_[toggle.cell.first][toggle.cell.second]
+                     .walls[toggle.wall];
+    wall = !wall;
+    maze_grid_[kOther.first][kOther.second].walls[OppositeWall(toggle.wall)] =
+        wall;
+    ++applied;
+    if (start_ != kNoCell) {
+      UpdateCell(IndexOf(toggle.cell));
+      UpdateCell(IndexOf(kOther));
+    }
+  }
+  return applied;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,92 @@
+#ifndef MAZE_DOMAIN_MAZE_INCREMENTAL_PLANNER_H
+#define MAZE_DOMAIN_MAZE_INCREMENTAL_PLANNER_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Flips the wall on side `wall` (0 top, 1 right, 2 bottom, 3 left) of `cell`
+// together with the matching wall of the neighbour.
+struct WallToggle {
+  GridPosition cell;
+  int wall;
+};
+
+struct PlannerStats {
+  // Cells whose g-value was settled or reset during the last Plan().
+  std::uint64_t expanded_ = 0;
+  // rhs-values recomputed by the last Plan() and the toggles before it.
+  std::uint64_t updated_ = 0;
+  std::uint64_t total_expanded_ = 0;
+};
+
+// Lifelong Planning A* between a fixed start and end. The planner owns a copy
+// of the maze and keeps g/rhs values between calls, so after
+// ApplyWallToggles() the next Plan() only re-expands cells whose distance
+// actually changed instead of searching the whole maze again. Plan() is what
+// does the work; toggles just mark the touched cells.
+class IncrementalPlanner {
+ public:
+  IncrementalPlanner(MazeDomain::MazeGrid maze_grid, GridPosition start_node,
+                     GridPosition end_node);
+
+  // Brings the search up to date and returns whether end is reachable.
+  bool Plan();
+  // Shortest start -> end path as of the last Plan(); empty when unreachable.
+  std::vector<GridPosition> Path() const;
+  // Number of toggles applied; toggles on the outer border or outside the
+  // maze are ignored.
+  size_t ApplyWallToggles(std::span<const WallToggle> toggles);
+
+  auto Maze() const -> const MazeDomain::MazeGrid& { return maze_grid_; }
+  auto Stats() const -> const PlannerStats& { return stats_; }
+
+ private:
+  struct Key {
+    std::uint32_t primary;
+    std::uint32_t secondary;
+
+    auto operator<=>(const Key&) const = default;
+  };
+
+  struct QueueEntry {
+    Key key;
+    int cell;
+  };
+
+  bool IsValidCell(GridPosition pos) const;
+  auto IndexOf(GridPosition pos) const -> int {
+    return (pos.first * width_) + pos.second;
+  }
+  auto PositionOf(int cell) const -> GridPosition {
+    return {cell / width_, cell % width_};
+  }
+  bool IsOpen(int cell, int wall) const;
+  int Neighbor(int cell, int wall) const;
+  std::uint32_t Heuristic(int cell) const;
+  Key CalculateKey(int cell) const;
+  void UpdateCell(int cell);
+  void PushCell(int cell);
+  bool IsStale(const QueueEntry& entry) const;
+  void DropStaleEntries();
+
+  MazeDomain::MazeGrid maze_grid_;
+  int height_ = 0;
+  int width_ = 0;
+  int start_ = -1;
+  int end_ = -1;
+  std::vector<std::uint32_t> g_;
+  std::vector<std::uint32_t> rhs_;
+  std::vector<QueueEntry> queue_;
+  PlannerStats stats_;
+  std::uint64_t pending_updates_ = 0;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_INCREMENTAL_PLANNER_H
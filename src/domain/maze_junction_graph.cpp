@@ -0,0 +1,311 @@
+#include "domain/maze_junction_graph.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <limits>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr int kNoNode = -1;
+constexpr int kNoEdge = -1;
+constexpr int kVirtualStart = -1;
+constexpr int kUnreachable = std::numeric_limits<int>::max();
+
+// Attachment codes: how a query endpoint reaches its graph node.
+constexpr int kAtNode = -1;
+constexpr int kOriginSide = -2;
+constexpr int kTargetSide = -3;
+constexpr int kDirect = -4;
+
+constexpr auto HeapAfter = [](const auto& left, const auto& right) -> bool {
+  if (left.f_score != right.f_score) {
+    return left.f_score > right.f_score;
+  }
+  return left.g_score < right.g_score;
+};
+
+auto NextCorridorDir(std::uint8_t open_mask, int arrival_dir) -> int {
+  const auto kBack =
+      static_cast<unsigned>(1U << MazeAdjacency::Opposite(arrival_dir));
+  return std::countr_zero(static_cast<unsigned>(open_mask) & ~kBack);
+}
+
+}  // namespace
+
+JunctionGraph::JunctionGraph(const MazeDomain::MazeGrid& maze_grid)
+    : adjacency_(maze_grid) {
+  const int kCellCount = adjacency_.CellCount();
+  node_of_cell_.assign(static_cast<size_t>(kCellCount), kNoNode);
+  anchor_.assign(static_cast<size_t>(kCellCount),
+                 CellAnchor{.edge = kNoEdge, .offset = 0});
+
+  for (int cell = 0; cell < kCellCount; ++cell) {
+    if (adjacency_.Degree(cell) != 2) {
+      node_of_cell_[cell] = static_cast<int>(node_cell_.size());
+      node_cell_.push_back(cell);
+    }
+  }
+  for (int node = 0; node < NodeCount(); ++node) {
+    TraceEdgesFrom(node);
+  }
+
+  // Closed rings of corridor cells have no natural node; promote one cell of
+  // each so every cell ends up either as a node or anchored on an edge.
+  for (int cell = 0; cell < kCellCount; ++cell) {
+    if (node_of_cell_[cell] == kNoNode && anchor_[cell].edge == kNoEdge) {
+      node_of_cell_[cell] = static_cast<int>(node_cell_.size());
+      node_cell_.push_back(cell);
+      TraceEdgesFrom(node_of_cell_[cell]);
+    }
+  }
+  edge_begin_.push_back(HalfEdgeCount());
+}
+
+void JunctionGraph::TraceEdgesFrom(int node) {
+  edge_begin_.push_back(HalfEdgeCount());
+  const int kOriginCell = node_cell_[node];
+  const std::uint8_t kOriginMask = adjacency_.OpenMask(kOriginCell);
+  for (int dir = 0; dir < MazeAdjacency::kDirectionCount; ++dir) {
+    if ((kOriginMask & (1U << dir)) == 0) {
+      continue;
+    }
+    const int kEdge = HalfEdgeCount();
+    int cell = adjacency_.Neighbor(kOriginCell, dir);
+    int arrival_dir = dir;
+    int length = 1;
+    while (node_of_cell_[cell] == kNoNode) {
+      if (anchor_[cell].edge == kNoEdge) {
+        anchor_[cell] = CellAnchor{.edge = kEdge, .offset = length};
+      }
+      arrival_dir = NextCorridorDir(adjacency_.OpenMask(cell), arrival_dir);
+      cell = adjacency_.Neighbor(cell, arrival_dir);
+      ++length;
+    }
+    edge_origin_.push_back(node);
+    edge_target_.push_back(node_of_cell_[cell]);
+    edge_length_.push_back(length);
+    edge_dir_.push_back(static_cast<std::uint8_t>(dir));
+  }
+}
+
+auto JunctionGraph::AttachmentsFor(int cell) const -> std::vector<Attachment> {
+  if (node_of_cell_[cell] != kNoNode) {
+    return {{.node = node_of_cell_[cell], .cost = 0, .code = kAtNode}};
+  }
+  const CellAnchor kAnchor = anchor_[cell];
+  return {{.node = edge_origin_[kAnchor.edge],
+           .cost = kAnchor.offset,
+           .code = kOriginSide},
+          {.node = edge_target_[kAnchor.edge],
+           .cost = edge_length_[kAnchor.edge] - kAnchor.offset,
+           .code = kTargetSide}};
+}
+
+void JunctionGraph::CollectCorridor(int edge, int steps,
+                                    std::vector<int>& cells) const {
+  int cell = node_cell_[edge_origin_[edge]];
+  int dir = edge_dir_[edge];
+  for (int step = 1; step <= steps; ++step) {
+    cell = adjacency_.Neighbor(cell, dir);
+    cells.push_back(cell);
+    if (step < steps) {
+      dir = NextCorridorDir(adjacency_.OpenMask(cell), dir);
+    }
+  }
+}
+
+void JunctionGraph::AppendFromStart(int start_cell, int code,
+                                    std::vector<int>& cells) const {
+  if (code == kAtNode) {
+    cells.push_back(start_cell);
+    return;
+  }
+  const CellAnchor kAnchor = anchor_[start_cell];
+  std::vector<int> corridor;
+  if (code == kOriginSide) {
+    CollectCorridor(kAnchor.edge, kAnchor.offset, corridor);
+    cells.insert(cells.end(), corridor.rbegin(), corridor.rend());
+    cells.push_back(node_cell_[edge_origin_[kAnchor.edge]]);
+    return;
+  }
+  CollectCorridor(kAnchor.edge, edge_length_[kAnchor.edge], corridor);
+  cells.insert(cells.end(), corridor.begin() + (kAnchor.offset - 1),
+               corridor.end());
+}
+
+void JunctionGraph::AppendToEnd(int end_cell, int code,
+                                std::vector<int>& cells) const {
+  if (code == kAtNode) {
+    return;
+  }
+  const CellAnchor kAnchor = anchor_[end_cell];
+  if (code == kOriginSide) {
+    CollectCorridor(kAnchor.edge, kAnchor.offset, cells);
+    return;
+  }
+  std::vector<int> corridor;
+  CollectCorridor(kAnchor.edge, edge_length_[kAnchor.edge] - 1, corridor);
+  cells.insert(cells.end(), corridor.rbegin(),
+               corridor.rend() - (kAnchor.offset - 1));
+}
+
+void JunctionGraph::AppendDirect(int start_cell, int end_cell,
+                                 std::vector<int>& cells) const {
+  const CellAnchor kStart = anchor_[start_cell];
+  const CellAnchor kEnd = anchor_[end_cell];
+  std::vector<int> corridor;
+  CollectCorridor(kStart.edge, std::max(kStart.offset, kEnd.offset), corridor);
+  if (kStart.offset <= kEnd.offset) {
+    cells.insert(cells.end(), corridor.begin() + (kStart.offset - 1),
+                 corridor.begin() + kEnd.offset);
+  } else {
+    cells.insert(cells.end(), corridor.rbegin(),
+                 corridor.rend() - (kEnd.offset - 1));
+  }
+}
+
+auto JunctionGraph::FindPath(GridPosition start_node,
+                             GridPosition end_node) const -> JunctionPath {
+  Workspace workspace;
+  return FindPath(start_node, end_node, workspace);
+}
+
+auto JunctionGraph::FindPath(GridPosition start_node, GridPosition end_node,
+                             Workspace& workspace, SearchBudget* budget) const
+    -> JunctionPath {
+  JunctionPath result;
+  const auto kInside = [this](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < Height() && pos.second >= 0 &&
+           pos.second < Width();
+  };
+  if (!kInside(start_node) || !kInside(end_node)) {
+    return result;
+  }
+  if (start_node == end_node) {
+    result.found_ = true;
+    result.path_.push_back(start_node);
+    return result;
+  }
+
+  const auto kNodeCount = static_cast<size_t>(NodeCount());
+  if (workspace.distance_.size() != kNodeCount) {
+    workspace.distance_.assign(kNodeCount, kUnreachable);
+    workspace.links_.assign(kNodeCount, {.prev_node = kVirtualStart,
+                                         .code = kAtNode});
+    workspace.seen_stamp_.assign(kNodeCount, 0);
+    workspace.closed_stamp_.assign(kNodeCount, 0);
+    workspace.epoch_ = 0;
+  }
+  if (++workspace.epoch_ == 0) {
+    std::ranges::fill(workspace.seen_stamp_, 0);
+    std::ranges::fill(workspace.closed_stamp_, 0);
+    workspace.epoch_ = 1;
+  }
+  const std::uint32_t kEpoch = workspace.epoch_;
+  auto& heap = workspace.heap_;
+  heap.clear();
+
+  const int kStartCell = adjacency_.IndexOf(start_node);
+  const int kEndCell = adjacency_.IndexOf(end_node);
+  const auto kHeuristic = [this, end_node](int node) -> int {
+    const GridPosition kPos = adjacency_.PositionOf(node_cell_[node]);
+    return std::abs(kPos.first - end_node.first) +
+           std::abs(kPos.second - end_node.second);
+  };
+  const auto kRelax = [&](int node, int g_score, int prev_node,
+                          int code) -> void {
+    if (workspace.seen_stamp_[node] == kEpoch &&
+        workspace.distance_[node] <= g_score) {
+      return;
+    }
+    workspace.seen_stamp_[node] = kEpoch;
+    workspace.distance_[node] = g_score;
+    workspace.links_[node] = {.prev_node = prev_node, .code = code};
+    heap.push_back({.f_score = g_score + kHeuristic(node),
+                    .g_score = g_score,
+                    .node = node});
+    std::ranges::push_heap(heap, HeapAfter);
+  };
+
+  int best_end = kUnreachable;
+  Workspace::Link end_link{.prev_node = kVirtualStart, .code = kAtNode};
+  const bool kSameCorridor =
+      node_of_cell_[kStartCell] == kNoNode &&
+      node_of_cell_[kEndCell] == kNoNode &&
+      anchor_[kStartCell].edge == anchor_[kEndCell].edge;
+  if (kSameCorridor) {
+    best_end = std::abs(anchor_[kStartCell].offset - anchor_[kEndCell].offset);
+    end_link = {.prev_node = kVirtualStart, .code = kDirect};
+  }
+
+  for (const Attachment& attachment : AttachmentsFor(kStartCell)) {
+    kRelax(attachment.node, attachment.cost, kVirtualStart, attachment.code);
+  }
+  const std::vector<Attachment> kEndAttachments = AttachmentsFor(kEndCell);
+
+  while (!heap.empty()) {
+    std::ranges::pop_heap(heap, HeapAfter);
+    const auto kEntry = heap.back();
+    heap.pop_back();
+    if (kEntry.f_score >= best_end) {
+      break;
+    }
+    const int kNode = kEntry.node;
+    if (workspace.closed_stamp_[kNode] == kEpoch ||
+        kEntry.g_score != workspace.distance_[kNode]) {
+      continue;
+    }
+    if (budget != nullptr && !budget->Spend()) {
+      return result;
+    }
+    workspace.closed_stamp_[kNode] = kEpoch;
+
+    for (const Attachment& attachment : kEndAttachments) {
+      if (attachment.node == kNode &&
+          kEntry.g_score + attachment.cost < best_end) {
+        best_end = kEntry.g_score + attachment.cost;
+        end_link = {.prev_node = kNode, .code = attachment.code};
+      }
+    }
+    for (int edge = edge_begin_[kNode]; edge < edge_begin_[kNode + 1];
+         ++edge) {
+      kRelax(edge_target_[edge], kEntry.g_score + edge_length_[edge], kNode,
+             edge);
+    }
+  }
+
+  if (best_end == kUnreachable) {
+    return result;
+  }
+
+  std::vector<int> cells;
+  cells.reserve(static_cast<size_t>(best_end) + 1);
+  if (end_link.code == kDirect) {
+    AppendDirect(kStartCell, kEndCell, cells);
+  } else {
+    std::vector<int> hops;
+    int node = end_link.prev_node;
+    while (workspace.links_[node].prev_node != kVirtualStart) {
+      hops.push_back(workspace.links_[node].code);
+      node = workspace.links_[node].prev_node;
+    }
+    AppendFromStart(kStartCell, workspace.links_[node].code, cells);
+    for (auto hop = hops.rbegin(); hop != hops.rend(); ++hop) {
+      CollectCorridor(*hop, edge_length_[*hop], cells);
+    }
+    AppendToEnd(kEndCell, end_link.code, cells);
+  }
+
+  result.found_ = true;
+  result.length_ = best_end;
+  result.path_.reserve(cells.size());
+  for (const int kCell : cells) {
+    result.path_.push_back(adjacency_.PositionOf(kCell));
+  }
+  return result;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,105 @@
+#ifndef MAZE_DOMAIN_MAZE_JUNCTION_GRAPH_H
+#define MAZE_DOMAIN_MAZE_JUNCTION_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_search_budget.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+struct JunctionPath {
+  bool found_ = false;
+  int length_ = 0;
+  std::vector<GridPosition> path_;
+};
+
+// Weighted graph over the cells that are not plain corridor cells (dead ends,
+// junctions, isolated cells). Every degree-2 run between two such nodes is
+// collapsed into one edge weighted by its step count, so a query only touches
+// nodes plus the corridors it finally has to report.
+//
+// Build once per maze; FindPath may run concurrently as long as every caller
+// passes its own Workspace.
+class JunctionGraph {
+ public:
+  class Workspace {
+   private:
+    friend class JunctionGraph;
+
+    struct Link {
+      int prev_node;
+      int code;
+    };
+
+    struct HeapEntry {
+      int f_score;
+      int g_score;
+      int node;
+    };
+
+    std::vector<int> distance_;
+    std::vector<Link> links_;
+    std::vector<std::uint32_t> seen_stamp_;
+    std::vector<std::uint32_t> closed_stamp_;
+    std::vector<HeapEntry> heap_;
+    std::uint32_t epoch_ = 0;
+  };
+
+  explicit JunctionGraph(const MazeDomain::MazeGrid& maze_grid);
+
+  auto Height() const -> int { return adjacency_.Height(); }
+  auto Width() const -> int { return adjacency_.Width(); }
+  auto NodeCount() const -> int { return static_cast<int>(node_cell_.size()); }
+  // Every corridor is stored once per direction of travel.
+  auto HalfEdgeCount() const -> int {
+    return static_cast<int>(edge_target_.size());
+  }
+
+  JunctionPath FindPath(GridPosition start_node, GridPosition end_node) const;
+  // With `budget`, every node the A* closes is charged to it; a stopped
+  // query reports no path.
+  JunctionPath FindPath(GridPosition start_node, GridPosition end_node,
+                        Workspace& workspace,
+                        SearchBudget* budget = nullptr) const;
+
+ private:
+  // A corridor cell lies `offset` steps along half-edge `edge`, counted from
+  // the edge's origin node.
+  struct CellAnchor {
+    int edge;
+    int offset;
+  };
+
+  // How a query endpoint joins the graph: at `node`, `cost` steps away.
+  struct Attachment {
+    int node;
+    int cost;
+    int code;
+  };
+
+  void TraceEdgesFrom(int node);
+  auto AttachmentsFor(int cell) const -> std::vector<Attachment>;
+  void CollectCorridor(int edge, int steps, std::vector<int>& cells) const;
+  void AppendFromStart(int start_cell, int code, std::vector<int>& cells) const;
+  void AppendToEnd(int end_cell, int code, std::vector<int>& cells) const;
+  void AppendDirect(int start_cell, int end_cell,
+                    std::vector<int>& cells) const;
+
+  MazeAdjacency adjacency_;
+  std::vector<int> node_of_cell_;
+  std::vector<CellAnchor> anchor_;
+  std::vector<int> node_cell_;
+  std::vector<int> edge_begin_;
+  std::vector<int> edge_origin_;
+  std::vector<int> edge_target_;
+  std::vector<int> edge_length_;
+  std::vector<std::uint8_t> edge_dir_;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_JUNCTION_GRAPH_H
@@ -0,0 +1,106 @@
+#include "domain/maze_landmarks.h"
+
+#include <algorithm>
+
+#include "domain/maze_distance_field.h"
+#include "domain/maze_search_kernel.h"
+#include "domain/maze_search_policies.h"
+#include "domain/maze_solver_algorithms.h"
+
+namespace MazeSolverDomain {
+
+LandmarkTable::LandmarkTable(const MazeAdjacency& adjacency,
+                             int landmark_count)
+    : height_(adjacency.Height()), width_(adjacency.Width()) {
+  const int kCellCount = adjacency.CellCount();
+  if (kCellCount == 0 || landmark_count <= 0) {
+    return;
+  }
+  count_ = std::min(landmark_count, kCellCount);
+  landmarks_.reserve(static_cast<size_t>(count_));
+  distances_.assign(static_cast<size_t>(kCellCount) * count_,
+                    kUnreachedDistance);
+
+  // Farthest reached cell, or any cell the field does not reach at all;
+  // the lowest index wins ties.
+  const auto kFarthest = [kCellCount](const std::vector<std::uint32_t>&
+                                          distances) -> int {
+    int farthest = 0;
+    for (int cell = 1; cell < kCellCount; ++cell) {
+      if (distances[cell] > distances[farthest]) {
+        farthest = cell;
+      }
+    }
+    return farthest;
+  };
+
+  std::vector<std::uint32_t> nearest_landmark =
+      ComputeDistanceField(adjacency, {0, 0}, 1).distances_;
+  for (int landmark = 0; landmark < count_; ++landmark) {
+    const int kCell = kFarthest(nearest_landmark);
+    landmarks_.push_back(adjacency.PositionOf(kCell));
+    const DistanceField kField =
+        ComputeDistanceField(adjacency, landmarks_.back(), 1);
+    for (int cell = 0; cell < kCellCount; ++cell) {
+      const std::uint32_t kDistance = kField.distances_[cell];
+      distances_[(static_cast<size_t>(cell) * count_) + landmark] = kDistance;
+      nearest_landmark[cell] =
+          landmark == 0 ? kDistance
+                        : std::min(nearest_landmark[cell], kDistance);
+    }
+  }
+}
+
+auto LandmarkTable::LowerBound(int cell,
+                               std::span<const std::uint32_t> target) const
+    -> int {
+  const auto kFrom = DistancesTo(cell);
+  std::uint32_t bound = 0;
+  for (size_t landmark = 0; landmark < kFrom.size(); ++landmark) {
+    const std::uint32_t kFromCell = kFrom[landmark];
+    const std::uint32_t kToTarget = target[landmark];
+    if (kFromCell == kUnreachedDistance || kToTarget == kUnreachedDistance) {
+      continue;
+    }
+    bound = std::max(bound, kFromCell > kToTarget ? kFromCell - kToTarget
+                                                  : kToTarget - kFromCell);
+  }
+  return static_cast<int>(bound);
+}
+
+auto SolveAStarWithLandmarks(const MazeDomain::MazeGrid& maze_grid,
+                             GridPosition start_node, GridPosition end_node,
+                             const LandmarkTable& landmarks,
+                             const SolveOptions& options) -> SearchResult {
+  const auto kGridSize = detail::GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (kGridSize->height != landmarks.Height() ||
+      kGridSize->width != landmarks.Width() || landmarks.Count() == 0) {
+    SolveOptions plain = options;
+    plain.landmark_count = 0;
+    plain.landmarks = nullptr;
+    return detail::SolveAStar(maze_grid, start_node, end_node, plain);
+  }
+  if (!detail::IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+
+  const detail::LandmarkAStarPolicy kPolicy{
+      .landmarks = &landmarks,
+      .target = landmarks.DistancesTo((end_node.first * landmarks.Width()) +
+                                      end_node.second)};
+  SearchResult result =
+      options.skip_corridors
+          ? detail::SolveWithPolicy(
+                maze_grid, start_node, end_node, options,
+                detail::CorridorSkipping<detail::LandmarkAStarPolicy>{kPolicy})
+          : detail::SolveWithPolicy(maze_grid, start_node, end_node, options,
+                                    kPolicy);
+  result.stats_.landmarks_ = static_cast<size_t>(landmarks.Count());
+  result.stats_.landmark_bytes_ = landmarks.Bytes();
+  return result;
+}
+
+}  // namespace MazeSolverDomain
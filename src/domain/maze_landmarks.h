@@ -0,0 +1,77 @@
+#ifndef MAZE_DOMAIN_MAZE_LANDMARKS_H
+#define MAZE_DOMAIN_MAZE_LANDMARKS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// BFS distances from a few landmark cells to every cell, for the ALT
+// (A*, Landmarks, Triangle inequality) heuristic. For any landmark L,
+// |d(L, target) - d(L, cell)| never exceeds d(cell, target), and the bound is
+// tight whenever the shortest path from L to one of the two runs through the
+// other, which Manhattan distance almost never is in a maze.
+//
+// Landmarks are picked by farthest-point selection: the first is the cell
+// farthest from (0,0), each next one the cell farthest from every landmark so
+// far (cells no landmark reaches come first, so every component gets one).
+// Distances are stored cell-major, so one heuristic evaluation reads a single
+// run of Count() values. Building costs one BFS per landmark plus one; the
+// table is read-only afterwards and safe to share between threads.
+class LandmarkTable {
+ public:
+  LandmarkTable(const MazeAdjacency& adjacency, int landmark_count);
+
+  auto Height() const -> int { return height_; }
+  auto Width() const -> int { return width_; }
+  auto Count() const -> int { return count_; }
+  auto Landmarks() const -> const std::vector<GridPosition>& {
+    return landmarks_;
+  }
+  // One distance per cell per landmark.
+  auto BytesPerLandmark() const -> size_t {
+    return static_cast<size_t>(height_) * width_ * sizeof(std::uint32_t);
+  }
+  auto Bytes() const -> size_t {
+    return distances_.size() * sizeof(std::uint32_t);
+  }
+
+  // Distances from every landmark to `cell` (a MazeAdjacency index).
+  auto DistancesTo(int cell) const -> std::span<const std::uint32_t> {
+    return {distances_.data() + (static_cast<size_t>(cell) * count_),
+            static_cast<size_t>(count_)};
+  }
+
+  // Lower bound on the steps from `cell` to the target whose DistancesTo()
+  // is `target`. Landmarks that cannot reach both are skipped.
+  auto LowerBound(int cell, std::span<const std::uint32_t> target) const
+      -> int;
+
+ private:
+  int height_ = 0;
+  int width_ = 0;
+  int count_ = 0;
+  std::vector<GridPosition> landmarks_;
+  std::vector<std::uint32_t> distances_;
+};
+
+// A* whose heuristic is the larger of the Manhattan distance and the
+// table's landmark bound. Both are consistent, so paths stay shortest and the
+// unit-step bucket frontier still applies; options.skip_corridors works as
+// for SolveAStar. A table built for another maze size falls back to plain
+// A*. stats_.landmarks_ / landmark_bytes_ report the table used.
+SearchResult SolveAStarWithLandmarks(const MazeDomain::MazeGrid& maze_grid,
+                                     GridPosition start_node,
+                                     GridPosition end_node,
+                                     const LandmarkTable& landmarks,
+                                     const SolveOptions& options = {});
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_LANDMARKS_H
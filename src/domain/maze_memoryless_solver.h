@@ -0,0 +1,238 @@
+#ifndef MAZE_DOMAIN_MAZE_MEMORYLESS_SOLVER_H
+#define MAZE_DOMAIN_MAZE_MEMORYLESS_SOLVER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "domain/maze_grid_access.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+struct WalkResult {
+  bool found_ = false;
+  // Cells moved by the walker, including retreats from dead ends.
+  std::uint64_t steps_ = 0;
+  // The keep_walking predicate ended the walk early.
+  bool stopped_ = false;
+};
+
+// Default keep_walking predicate: walk until the end or a proven dead end.
+struct AlwaysWalk {
+  constexpr auto operator()() const -> bool { return true; }
+};
+
+namespace walk_detail {
+
+inline constexpr int kDirectionCount = MazeDomain::kWallCount;
+inline constexpr std::array<int, kDirectionCount> kRowDelta = {-1, 0, 1, 0};
+inline constexpr std::array<int, kDirectionCount> kColDelta = {0, 1, 0, -1};
+inline constexpr int kRight = 1;
+inline constexpr int kBottom = 2;
+
+constexpr auto Opposite(int dir) -> int { return (dir + 2) % kDirectionCount; }
+
+constexpr auto Step(GridPosition pos, int dir) -> GridPosition {
+  return {pos.first + kRowDelta[dir], pos.second + kColDelta[dir]};
+}
+
+template <WallGridAccess Grid>
+auto IsInside(const Grid& grid, GridPosition pos) -> bool {
+  return pos.first >= 0 && pos.first < grid.Height() && pos.second >= 0 &&
+         pos.second < grid.Width();
+}
+
+template <WallGridAccess Grid>
+auto IsPassable(const Grid& grid, GridPosition pos, int dir) -> bool {
+  return IsInside(grid, Step(pos, dir)) &&
+         !grid.HasWall(pos.first, pos.second, dir);
+}
+
+}  // namespace walk_detail
+
+// Right-hand wall follower. Keeps only the current cell and heading, so it
+// runs in O(1) memory on any WallGridAccess backend. Guaranteed to reach the
+// end only in simply connected (perfect) mazes; elsewhere it may circle an
+// island and report "not found" once it is back in its starting state.
+// `on_step` receives every cell the walker enters, starting with start_node;
+// `keep_walking` is asked before every step and stops the walk on false.
+template <WallGridAccess Grid, typename OnStep,
+          typename KeepWalking = AlwaysWalk>
+auto FollowWall(const Grid& grid, GridPosition start_node,
+                GridPosition end_node, OnStep&& on_step,
+                KeepWalking keep_walking = {}) -> WalkResult {
+  using namespace walk_detail;
+  WalkResult result;
+  if (!IsInside(grid, start_node) || !IsInside(grid, end_node)) {
+    return result;
+  }
+  on_step(start_node);
+  if (start_node == end_node) {
+    result.found_ = true;
+    return result;
+  }
+
+  // Pretend we arrived through an open side; that makes (start, heading) a
+  // state the walk cycles back to, which is how an unreachable end shows.
+  int heading = -1;
+  for (int dir = 0; dir < kDirectionCount; ++dir) {
+    if (IsPassable(grid, start_node, dir)) {
+      heading = Opposite(dir);
+      break;
+    }
+  }
+  if (heading < 0) {
+    return result;
+  }
+  const int kInitialHeading = heading;
+
+  // Right, straight, left, back relative to the heading.
+  constexpr std::array<int, kDirectionCount> kTurns = {1, 0, 3, 2};
+  GridPosition pos = start_node;
+  while (true) {
+    if (!keep_walking()) {
+      result.stopped_ = true;
+      return result;
+    }
+    for (const int kTurn : kTurns) {
+      const int kDir = (heading + kTurn) % kDirectionCount;
+      if (IsPassable(grid, pos, kDir)) {
+        heading = kDir;
+        break;
+      }
+    }
+    pos = Step(pos, heading);
+    ++result.steps_;
+    on_step(pos);
+    if (pos == end_node) {
+      result.found_ = true;
+      return result;
+    }
+    if (pos == start_node && heading == kInitialHeading) {
+      return result;
+    }
+  }
+}
+
+// Trémaux marks: how often each passage was walked (0, 1 or 2), two bits per
+// passage. A cell owns its right and bottom passages, so a whole maze needs
+// one byte per two cells.
+class TremauxMarks {
+ public:
+  TremauxMarks(int height, int width)
+      : width_(static_cast<std::uint64_t>(width)),
+        bits_((static_cast<std::uint64_t>(height) * width_ * 2 + 3) / 4, 0) {}
+
+  auto Get(GridPosition pos, int dir) const -> int {
+    const std::uint64_t kSlot = SlotOf(pos, dir);
+    return (bits_[kSlot / 4] >> ((kSlot % 4) * 2)) & 0x3;
+  }
+  void Increment(GridPosition pos, int dir) {
+    const std::uint64_t kSlot = SlotOf(pos, dir);
+    bits_[kSlot / 4] =
+        static_cast<std::uint8_t>(bits_[kSlot / 4] + (1U << ((kSlot % 4) * 2)));
+  }
+  auto ByteSize() const -> size_t { return bits_.size(); }
+
+ private:
+  auto SlotOf(GridPosition pos, int dir) const -> std::uint64_t {
+    if (dir != walk_detail::kRight && dir != walk_detail::kBottom) {
+      pos = walk_detail::Step(pos, dir);
+      dir = walk_detail::Opposite(dir);
+    }
+    const std::uint64_t kCell =
+        (static_cast<std::uint64_t>(pos.first) * width_) +
+        static_cast<std::uint64_t>(pos.second);
+    return (kCell * 2) + (dir == walk_detail::kRight ? 0 : 1);
+  }
+
+  std::uint64_t width_;
+  std::vector<std::uint8_t> bits_;
+};
+
+// Trémaux's algorithm: finds the end in any maze (loops included) without
+// visited/parent grids, only TremauxMarks. Passages walked exactly once form
+// the route, which is streamed start -> end through `on_path` when found. A
+// walk stopped by `keep_walking` streams the route to where it stopped.
+template <WallGridAccess Grid, typename OnPath,
+          typename KeepWalking = AlwaysWalk>
+auto WalkTremaux(const Grid& grid, GridPosition start_node,
+                 GridPosition end_node, OnPath&& on_path,
+                 KeepWalking keep_walking = {}) -> WalkResult {
+  using namespace walk_detail;
+  WalkResult result;
+  if (!IsInside(grid, start_node) || !IsInside(grid, end_node)) {
+    return result;
+  }
+  if (start_node == end_node) {
+    on_path(start_node);
+    result.found_ = true;
+    return result;
+  }
+
+  TremauxMarks marks(grid.Height(), grid.Width());
+  GridPosition pos = start_node;
+  int entered = -1;
+  while (pos != end_node) {
+    if (!keep_walking()) {
+      result.stopped_ = true;
+      break;
+    }
+    bool seen_before = false;
+    int exit = -1;
+    int fewest_marks = 2;
+    for (int dir = 0; dir < kDirectionCount; ++dir) {
+      if (dir == entered || !IsPassable(grid, pos, dir)) {
+        continue;
+      }
+      const int kMarks = marks.Get(pos, dir);
+      seen_before = seen_before || kMarks > 0;
+      if (kMarks < fewest_marks) {
+        fewest_marks = kMarks;
+        exit = dir;
+      }
+    }
+    const int kEnteredMarks = entered < 0 ? 2 : marks.Get(pos, entered);
+    // Reaching an already visited cell through a new passage: go back.
+    if ((seen_before && kEnteredMarks == 1) ||
+        (exit < 0 && kEnteredMarks < 2)) {
+      exit = entered;
+    }
+    if (exit < 0) {
+      return result;
+    }
+    marks.Increment(pos, exit);
+    pos = Step(pos, exit);
+    entered = Opposite(exit);
+    ++result.steps_;
+  }
+
+  const GridPosition kRouteEnd = pos;
+  result.found_ = kRouteEnd == end_node;
+  pos = start_node;
+  int came_from = -1;
+  on_path(pos);
+  while (pos != kRouteEnd) {
+    int next = -1;
+    for (int dir = 0; dir < kDirectionCount; ++dir) {
+      if (dir != came_from && IsPassable(grid, pos, dir) &&
+          marks.Get(pos, dir) == 1) {
+        next = dir;
+        break;
+      }
+    }
+    if (next < 0) {
+      break;
+    }
+    pos = Step(pos, next);
+    came_from = Opposite(next);
+    on_path(pos);
+  }
+  return result;
+}
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_MEMORYLESS_SOLVER_H
@@ -0,0 +1,161 @@
+#include "domain/maze_multi_target_solver.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "domain/maze_search_kernel.h"
+
+namespace MazeSolverDomain {
+
+namespace {
+
+// Goal set for RunSearch: any exit stops the search. Key is the g-score
+// alone (BFS ignores it, Dijkstra orders by it) or, with `heuristic`, the
+// g-score plus the Manhattan distance to the closest exit (A*).
+template <typename FrontierType, detail::Discovery kDiscoveryType>
+struct ExitSetPolicy {
+  using Frontier = FrontierType;
+  static constexpr detail::Discovery kDiscovery = kDiscoveryType;
+  static constexpr auto kNeighborOrder = detail::kQueueNeighborOrder;
+
+  auto Key(int g_score, GridPosition cell, GridPosition /*end*/) const
+      -> int {
+    if (heuristic == nullptr) {
+      return g_score;
+    }
+    return g_score + (*heuristic)[(cell.first * width) + cell.second];
+  }
+  auto IsGoal(int cell) const -> bool { return exits->Test(cell); }
+
+  const detail::CellBitset* exits = nullptr;
+  const std::vector<int>* heuristic = nullptr;
+  int width = 0;
+};
+
+using ExitBfsPolicy =
+    ExitSetPolicy<detail::FifoFrontier, detail::Discovery::kMarkOnPush>;
+using ExitDijkstraPolicy =
+    ExitSetPolicy<detail::BucketFrontier<1>, detail::Discovery::kRelaxCost>;
+// Unit passages keep f-scores monotone with steps of 0 or 2.
+using ExitAStarPolicy =
+    ExitSetPolicy<detail::BucketFrontier<2>, detail::Discovery::kRelaxCost>;
+
+// Manhattan distance from every cell to its closest exit: a forward pass
+// pulls distances from the top and left, a backward pass from the bottom and
+// right, which is exact for the L1 metric.
+auto ExitDistances(const MazeAdjacency& adjacency,
+                   const detail::CellBitset& exits) -> std::vector<int> {
+  const int kFarAway =
+      std::numeric_limits<int>::max() / detail::kMaxCostDivisor;
+  const int kHeight = adjacency.Height();
+  const int kWidth = adjacency.Width();
+  std::vector<int> distances(static_cast<size_t>(adjacency.CellCount()));
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = 0; col < kWidth; ++col) {
+      const int kCell = (row * kWidth) + col;
+      int best = exits.Test(kCell) ? 0 : kFarAway;
+      if (row > 0) {
+        best = std::min(best, distances[kCell - kWidth] + 1);
+      }
+      if (col > 0) {
+        best = std::min(best, distances[kCell - 1] + 1);
+      }
+      distances[kCell] = best;
+    }
+  }
+  for (int row = kHeight - 1; row >= 0; --row) {
+    for (int col = kWidth - 1; col >= 0; --col) {
+      const int kCell = (row * kWidth) + col;
+      int best = distances[kCell];
+      if (row < kHeight - 1) {
+        best = std::min(best, distances[kCell + kWidth] + 1);
+      }
+      if (col < kWidth - 1) {
+        best = std::min(best, distances[kCell + 1] + 1);
+      }
+      distances[kCell] = best;
+    }
+  }
+  return distances;
+}
+
+}  // namespace
+
+auto SolveNearestExit(const MazeDomain::MazeGrid& maze_grid,
+                      GridPosition start_node,
+                      std::span<const GridPosition> exits,
+                      SolverAlgorithmType algorithm_type,
+                      const SolveOptions& options) -> ExitSearchResult {
+  ExitSearchResult result;
+  const MazeAdjacency kAdjacency(maze_grid);
+  const auto kInside = [&kAdjacency](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < kAdjacency.Height() &&
+           pos.second >= 0 && pos.second < kAdjacency.Width();
+  };
+  if (kAdjacency.CellCount() == 0 || !kInside(start_node)) {
+    return result;
+  }
+
+  detail::CellBitset exit_cells(kAdjacency.CellCount());
+  bool has_exit = false;
+  for (const GridPosition& exit : exits) {
+    if (kInside(exit)) {
+      exit_cells.Set(kAdjacency.IndexOf(exit));
+      has_exit = true;
+    }
+  }
+  if (!has_exit) {
+    return result;
+  }
+
+  SearchBudget budget(options);
+  const auto kCellCount = static_cast<size_t>(kAdjacency.CellCount());
+  detail::SearchState state{
+      .visited = std::vector<std::uint8_t>(kCellCount, 0),
+      .parents = std::vector<int>(kCellCount, detail::kNoCell)};
+  // Only the recorder's no-op hooks run; the result is built below.
+  SearchResult unused_result;
+  detail::NullRecorder recorder(kAdjacency, budget, unused_result);
+  // With a goal set, endpoints.end only reaches Key, which ignores it.
+  const detail::PathEndpoints kEndpoints{.start = start_node,
+                                         .end = start_node};
+  const auto kRun = [&]<typename Policy>(const Policy& policy) -> bool {
+    return detail::RunSearch<Policy>(kAdjacency, kEndpoints, budget, recorder,
+                                     state, result.stats_, policy);
+  };
+  bool found = false;
+  switch (algorithm_type) {
+    case SolverAlgorithmType::ASTAR: {
+      const auto kHeuristic = ExitDistances(kAdjacency, exit_cells);
+      if (budget.Poll()) {
+        found = kRun(ExitAStarPolicy{.exits = &exit_cells,
+                                     .heuristic = &kHeuristic,
+                                     .width = kAdjacency.Width()});
+      }
+      break;
+    }
+    case SolverAlgorithmType::DIJKSTRA:
+      found = kRun(ExitDijkstraPolicy{.exits = &exit_cells});
+      break;
+    default:
+      found = kRun(ExitBfsPolicy{.exits = &exit_cells});
+      break;
+  }
+
+  result.termination_ = budget.Termination();
+  result.stats_.expanded_ = budget.Expanded();
+  if (!found) {
+    return result;
+  }
+  result.found_ = true;
+  result.path_ = detail::ExtractCellPath(kAdjacency, state.parents,
+                                         kAdjacency.IndexOf(start_node),
+                                         state.goal);
+  const GridPosition kExit = kAdjacency.PositionOf(state.goal);
+  result.exit_index_ = static_cast<size_t>(
+      std::ranges::find(exits, kExit) - exits.begin());
+  return result;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,38 @@
+#ifndef MAZE_DOMAIN_MAZE_MULTI_TARGET_SOLVER_H
+#define MAZE_DOMAIN_MAZE_MULTI_TARGET_SOLVER_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+struct ExitSearchResult {
+  bool found_ = false;
+  // Index into the exits passed in of the exit that was reached.
+  size_t exit_index_ = 0;
+  std::vector<GridPosition> path_;
+  // A stopped search reports no path.
+  SearchTermination termination_ = SearchTermination::COMPLETED;
+  SearchStats stats_;
+};
+
+// Nearest reachable exit from `start_node`, found by one search instead of
+// one per exit. Exits live in a per-cell bitset that the shared search
+// kernel takes as its goal set, so the search stops at the first exit it
+// expands. BFS and DIJKSTRA grow a plain frontier. ASTAR uses
+// the Manhattan distance to the closest exit, precomputed for every cell by
+// an L1 distance transform, which stays consistent for the whole set. Other
+// algorithm types run BFS; exits outside the grid are ignored.
+ExitSearchResult SolveNearestExit(const MazeDomain::MazeGrid& maze_grid,
+                                  GridPosition start_node,
+                                  std::span<const GridPosition> exits,
+                                  SolverAlgorithmType algorithm_type,
+                                  const SolveOptions& options = {});
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_MULTI_TARGET_SOLVER_H
@@ -0,0 +1,142 @@
+#include "domain/maze_path_index.h"
+
+#include <algorithm>
+
+#include "domain/maze_adjacency.h"
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr int kNoParent = -1;
+
+}  // namespace
+
+TreePathIndex::TreePathIndex(int height, int width)
+    : height_(height), width_(width) {
+  const auto kCellCount =
+      static_cast<size_t>(height) * static_cast<size_t>(width);
+  parent_.assign(kCellCount, kNoParent);
+  depth_.assign(kCellCount, 0);
+  jump_.assign(kCellCount, 0);
+}
+
+auto TreePathIndex::Build(const MazeDomain::MazeGrid& maze_grid)
+    -> std::optional<TreePathIndex> {
+  const MazeAdjacency kAdjacency(maze_grid);
+  const int kCellCount = kAdjacency.CellCount();
+  if (kCellCount == 0) {
+    return std::nullopt;
+  }
+
+  long long open_sides = 0;
+  for (int cell = 0; cell < kCellCount; ++cell) {
+    open_sides += kAdjacency.Degree(cell);
+  }
+  // A spanning tree has exactly n - 1 passages, each seen from both sides.
+  if (open_sides != 2LL * (kCellCount - 1)) {
+    return std::nullopt;
+  }
+
+  TreePathIndex index(kAdjacency.Height(), kAdjacency.Width());
+  std::vector<int> order;
+  order.reserve(static_cast<size_t>(kCellCount));
+  std::vector<bool> reached(static_cast<size_t>(kCellCount), false);
+  order.push_back(0);
+  reached[0] = true;
+
+  for (size_t head = 0; head < order.size(); ++head) {
+    const int kCell = order[head];
+    for (int dir = 0; dir < MazeAdjacency::kDirectionCount; ++dir) {
+      if (!kAdjacency.IsOpen(kCell, dir)) {
+        continue;
+      }
+      const int kNext = kAdjacency.Neighbor(kCell, dir);
+      if (reached[kNext]) {
+        continue;
+      }
+      reached[kNext] = true;
+      index.parent_[kNext] = kCell;
+      index.depth_[kNext] = index.depth_[kCell] + 1;
+
+      // Skew-binary jump pointers: jump two equal-length jumps at once when
+      // the parent's chain allows it, otherwise jump to the parent.
+      const int kJump = index.jump_[kCell];
+      const int kJumpJump = index.jump_[kJump];
+      const bool kMergeJumps =
+          index.depth_[kCell] - index.depth_[kJump] ==
+          index.depth_[kJump] - index.depth_[kJumpJump];
+      index.jump_[kNext] = kMergeJumps ? kJumpJump : kCell;
+      order.push_back(kNext);
+    }
+  }
+
+  if (static_cast<int>(order.size()) != kCellCount) {
+    return std::nullopt;
+  }
+  return index;
+}
+
+auto TreePathIndex::AncestorAtDepth(int cell, int depth) const -> int {
+  while (depth_[cell] > depth) {
+    cell = depth_[jump_[cell]] >= depth ? jump_[cell] : parent_[cell];
+  }
+  return cell;
+}
+
+auto TreePathIndex::LcaIndex(int first, int second) const -> int {
+  if (depth_[first] > depth_[second]) {
+    first = AncestorAtDepth(first, depth_[second]);
+  } else {
+    second = AncestorAtDepth(second, depth_[first]);
+  }
+  // Jump targets depend only on depth, so both cells move in lockstep.
+  while (first != second) {
+    if (jump_[first] != jump_[second]) {
+      first = jump_[first];
+      second = jump_[second];
+    } else {
+      first = parent_[first];
+      second = parent_[second];
+    }
+  }
+  return first;
+}
+
+auto TreePathIndex::LowestCommonAncestor(GridPosition first,
+                                         GridPosition second) const
+    -> GridPosition {
+  return PositionOf(LcaIndex(IndexOf(first), IndexOf(second)));
+}
+
+auto TreePathIndex::Distance(GridPosition first, GridPosition second) const
+    -> int {
+  const int kFirst = IndexOf(first);
+  const int kSecond = IndexOf(second);
+  const int kLca = LcaIndex(kFirst, kSecond);
+  return depth_[kFirst] + depth_[kSecond] - (2 * depth_[kLca]);
+}
+
+auto TreePathIndex::Path(GridPosition first, GridPosition second) const
+    -> std::vector<GridPosition> {
+  const int kFirst = IndexOf(first);
+  const int kSecond = IndexOf(second);
+  const int kLca = LcaIndex(kFirst, kSecond);
+
+  std::vector<GridPosition> path;
+  path.reserve(static_cast<size_t>(depth_[kFirst] + depth_[kSecond] -
+                                   (2 * depth_[kLca]) + 1));
+  for (int cell = kFirst; cell != kLca; cell = parent_[cell]) {
+    path.push_back(PositionOf(cell));
+  }
+  path.push_back(PositionOf(kLca));
+  const size_t kUpwardSize = path.size();
+  for (int cell = kSecond; cell != kLca; cell = parent_[cell]) {
+    path.push_back(PositionOf(cell));
+  }
+  std::reverse(path.begin() + static_cast<std::ptrdiff_t>(kUpwardSize),
+               path.end());
+  return path;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,58 @@
+#ifndef MAZE_DOMAIN_MAZE_PATH_INDEX_H
+#define MAZE_DOMAIN_MAZE_PATH_INDEX_H
+
+#include <optional>
+#include <vector>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Path index for perfect mazes (the passages form a spanning tree, as with
+// DFS, Prims, Kruskal, Recursive Division and Growing Tree). The tree is
+// rooted at cell (0,0); each cell keeps its parent, depth and one skew-binary
+// jump pointer, which gives O(log n) lowest-common-ancestor queries with
+// three ints of memory per cell. Queries never search the maze.
+//
+// All queries are const and safe to run concurrently.
+class TreePathIndex {
+ public:
+  // Returns std::nullopt when the maze is not a single spanning tree
+  // (disconnected, or braided with loops).
+  static std::optional<TreePathIndex> Build(
+      const MazeDomain::MazeGrid& maze_grid);
+
+  auto Height() const -> int { return height_; }
+  auto Width() const -> int { return width_; }
+
+  GridPosition LowestCommonAncestor(GridPosition first,
+                                    GridPosition second) const;
+  // Number of steps on the unique path between the two cells.
+  int Distance(GridPosition first, GridPosition second) const;
+  // Cells of the unique path, both endpoints included; O(path length).
+  std::vector<GridPosition> Path(GridPosition first,
+                                 GridPosition second) const;
+
+ private:
+  TreePathIndex(int height, int width);
+
+  auto IndexOf(GridPosition pos) const -> int {
+    return (pos.first * width_) + pos.second;
+  }
+  auto PositionOf(int index) const -> GridPosition {
+    return {index / width_, index % width_};
+  }
+  auto AncestorAtDepth(int cell, int depth) const -> int;
+  auto LcaIndex(int first, int second) const -> int;
+
+  int height_;
+  int width_;
+  std::vector<int> parent_;
+  std::vector<int> depth_;
+  std::vector<int> jump_;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_PATH_INDEX_H
@@ -0,0 +1,92 @@
+#ifndef MAZE_DOMAIN_MAZE_RADIX_HEAP_H
+#define MAZE_DOMAIN_MAZE_RADIX_HEAP_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace MazeSolverDomain {
+
+// Monotone radix heap for unsigned 32-bit keys: a pushed key must be at least
+// the last popped key, which holds for Dijkstra and for A* with a consistent
+// heuristic. Bucket i holds keys whose highest bit differing from the last
+// popped key is bit i - 1, so each entry moves down at most 32 times and a
+// push is O(1). Pop refills bucket 0 from the lowest non-empty bucket only
+// when it runs dry. Bucket vectors keep their capacity across Clear().
+template <typename Value>
+class RadixHeap {
+ public:
+  using Key = std::uint32_t;
+
+  auto Empty() const -> bool { return size_ == 0; }
+  auto Size() const -> size_t { return size_; }
+
+  void Push(Key key, const Value& value) {
+    buckets_[BucketOf(key)].emplace_back(key, value);
+    ++size_;
+  }
+
+  // Smallest key in the heap. Requires !Empty().
+  auto MinKey() -> Key {
+    Refill();
+    return last_;
+  }
+
+  // Removes and returns an entry with the smallest key. Requires !Empty().
+  auto Pop() -> Value {
+    Refill();
+    auto& bucket = buckets_.front();
+    const Value kValue = bucket.back().second;
+    bucket.pop_back();
+    --size_;
+    return kValue;
+  }
+
+  void Clear() {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    size_ = 0;
+    last_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBucketCount = std::numeric_limits<Key>::digits + 1;
+
+  auto BucketOf(Key key) const -> size_t {
+    return static_cast<size_t>(std::bit_width(key ^ last_));
+  }
+
+  void Refill() {
+    if (!buckets_.front().empty()) {
+      return;
+    }
+    size_t index = 1;
+    while (buckets_[index].empty()) {
+      ++index;
+    }
+    auto& source = buckets_[index];
+    Key new_last = source.front().first;
+    for (const auto& entry : source) {
+      new_last = std::min(new_last, entry.first);
+    }
+    last_ = new_last;
+    for (const auto& entry : source) {
+      buckets_[BucketOf(entry.first)].push_back(entry);
+    }
+    source.clear();
+  }
+
+  std::array<std::vector<std::pair<Key, Value>>, kBucketCount> buckets_;
+  size_t size_ = 0;
+  Key last_ = 0;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_RADIX_HEAP_H
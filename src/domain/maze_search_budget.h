@@ -0,0 +1,103 @@
+#ifndef MAZE_DOMAIN_MAZE_SEARCH_BUDGET_H
+#define MAZE_DOMAIN_MAZE_SEARCH_BUDGET_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Enforces SolveOptions from inside a search loop. Spend() runs once per
+// expanded cell and is a single compare on the fast path; the node limit, the
+// clock and the stop token are only consulted when the expansion count hits
+// the next checkpoint (the node limit, or every kPollInterval expansions).
+class SearchBudget {
+ public:
+  static constexpr size_t kPollInterval = 1024;
+
+  explicit SearchBudget(const SolveOptions& options)
+      : options_(options),
+        node_limit_(options.max_expanded_nodes == 0
+                        ? std::numeric_limits<size_t>::max()
+                        : options.max_expanded_nodes),
+        frame_limit_(options.max_frames == 0
+                         ? std::numeric_limits<size_t>::max()
+                         : options.max_frames) {}
+
+  // Accounts for one expansion; false means stop before expanding it.
+  auto Spend() -> bool {
+    if (expanded_ == next_check_ && !CheckLimits()) {
+      return false;
+    }
+    ++expanded_;
+    return true;
+  }
+
+  // Accounts for `count` expansions made as one step of a bit-parallel
+  // search; false means stop before the step. A step is never split, so the
+  // node limit may stop such a search up to one step early.
+  auto SpendMany(size_t count) -> bool {
+    if (count > node_limit_ - expanded_) {
+      termination_ = SearchTermination::NODE_LIMIT;
+      return false;
+    }
+    if (expanded_ + count > next_check_) {
+      if (!Poll()) {
+        return false;
+      }
+      next_check_ = expanded_ + count + kPollInterval;
+    }
+    expanded_ += count;
+    return true;
+  }
+
+  // Deadline and stop token only, for work without a per-cell loop.
+  auto Poll() -> bool {
+    if (options_.stop_token.stop_requested()) {
+      termination_ = SearchTermination::CANCELLED;
+      return false;
+    }
+    if (options_.deadline != std::chrono::steady_clock::time_point::max() &&
+        std::chrono::steady_clock::now() >= options_.deadline) {
+      termination_ = SearchTermination::DEADLINE;
+      return false;
+    }
+    return true;
+  }
+
+  auto CanRecordFrame(size_t frames_recorded) const -> bool {
+    return frames_recorded < frame_limit_;
+  }
+  auto Stopped() const -> bool {
+    return termination_ != SearchTermination::COMPLETED;
+  }
+  auto Termination() const -> SearchTermination { return termination_; }
+  auto Expanded() const -> size_t { return expanded_; }
+
+ private:
+  auto CheckLimits() -> bool {
+    if (expanded_ >= node_limit_) {
+      termination_ = SearchTermination::NODE_LIMIT;
+      return false;
+    }
+    if (!Poll()) {
+      return false;
+    }
+    next_check_ = std::min(node_limit_, expanded_ + kPollInterval);
+    return true;
+  }
+
+  const SolveOptions& options_;
+  size_t node_limit_;
+  size_t frame_limit_;
+  size_t expanded_ = 0;
+  size_t next_check_ = 0;
+  SearchTermination termination_ = SearchTermination::COMPLETED;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_SEARCH_BUDGET_H
@@ -0,0 +1,617 @@
+#ifndef MAZE_DOMAIN_MAZE_SEARCH_KERNEL_H
+#define MAZE_DOMAIN_MAZE_SEARCH_KERNEL_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_bucket_queue.h"
+#include "domain/maze_radix_heap.h"
+#include "domain/maze_solver_common.h"
+
+namespace MazeSolverDomain::detail {
+
+// Neighbour orders; they decide which of several equally short paths a
+// solver reports.
+inline constexpr std::array<int, kWallCount> kQueueNeighborOrder = {
+    kWallTop, kWallBottom, kWallLeft, kWallRight};
+inline constexpr std::array<int, kWallCount> kStackNeighborOrder = {
+    kWallTop, kWallRight, kWallBottom, kWallLeft};
+
+inline constexpr int kNoCell = -1;
+
+// How a search treats a neighbour it reaches:
+//  kMarkOnPush  - visited on discovery, never queued twice (BFS).
+//  kRelaxCost   - queued again whenever its g-score improves (Dijkstra, A*).
+//  kFirstParent - queued on every discovery, parent kept from the first one
+//                 (Greedy Best-First).
+//  kDepthFirst  - one neighbour per step; the current cell stays on the
+//                 frontier until it has none left (DFS).
+enum class Discovery { kMarkOnPush, kRelaxCost, kFirstParent, kDepthFirst };
+
+// Start and end as MazeAdjacency cell indices.
+struct CellEndpoints {
+  int start;
+  int end;
+};
+
+// Per-search state, indexed like MazeAdjacency cells. A cell is visited, or
+// its g-score and parent are set, only when its stamp equals `mark`, so one
+// state serves many searches: Begin() bumps the mark instead of clearing the
+// arrays, and wipes them only when the 8-bit mark wraps. A state built with
+// zeroed `visited` and kNoCell `parents` is ready for its first search.
+struct SearchState {
+  void Begin(int cell_count) {
+    const auto kCellCount = static_cast<size_t>(cell_count);
+    if (visited.size() != kCellCount) {
+      visited.assign(kCellCount, 0);
+      parents.assign(kCellCount, kNoCell);
+      reached.clear();
+      mark = 1;
+    } else if (++mark == 0) {
+      std::ranges::fill(visited, 0);
+      std::ranges::fill(reached, 0);
+      mark = 1;
+    }
+  }
+
+  std::vector<std::uint8_t> visited;
+  std::vector<int> parents;
+  // Stamps for g_scores and first parents (kRelaxCost, kFirstParent); sized
+  // by the first search that needs them.
+  std::vector<std::uint8_t> reached;
+  std::vector<int> g_scores;
+  std::uint8_t mark = 1;
+  // Cell the search stopped at when it found a goal.
+  int goal = kNoCell;
+};
+
+// One bit per maze cell.
+class CellBitset {
+ public:
+  explicit CellBitset(int cell_count)
+      : words_((static_cast<size_t>(cell_count) + kWordBits - 1) / kWordBits,
+               0) {}
+
+  void Set(int cell) {
+    words_[static_cast<size_t>(cell) / kWordBits] |=
+        std::uint64_t{1} << (static_cast<size_t>(cell) % kWordBits);
+  }
+  auto Test(int cell) const -> bool {
+    return ((words_[static_cast<size_t>(cell) / kWordBits] >>
+             (static_cast<size_t>(cell) % kWordBits)) &
+            1U) != 0;
+  }
+
+ private:
+  static constexpr size_t kWordBits = 64;
+  std::vector<std::uint64_t> words_;
+};
+
+// --- Frontiers: Push(key, cell), Pop(), Top(), Empty(), Size(). ---
+
+// Every cell is queued at most once, so a vector with a read head is enough.
+class FifoFrontier {
+ public:
+  void Push(int /*key*/, int cell) { queue_.push_back(cell); }
+  auto Pop() -> int { return queue_[head_++]; }
+  auto Empty() const -> bool { return head_ == queue_.size(); }
+  auto Size() const -> size_t { return queue_.size() - head_; }
+
+ private:
+  std::vector<int> queue_;
+  size_t head_ = 0;
+};
+
+class LifoFrontier {
+ public:
+  void Push(int /*key*/, int cell) { stack_.push_back(cell); }
+  auto Top() const -> int { return stack_.back(); }
+  void Pop() { stack_.pop_back(); }
+  auto Empty() const -> bool { return stack_.empty(); }
+  auto Size() const -> size_t { return stack_.size(); }
+
+ private:
+  std::vector<int> stack_;
+};
+
+// Monotone keys that grow by at most kMaxKeyStep per edge.
+template <int kMaxKeyStep>
+class BucketFrontier {
+ public:
+  void Push(int key, int cell) { queue_.Push(key, cell); }
+  auto Pop() -> int { return queue_.Pop(); }
+  auto Empty() const -> bool { return queue_.Empty(); }
+  auto Size() const -> size_t { return queue_.Size(); }
+
+ private:
+  BucketQueue<int> queue_{kMaxKeyStep};
+};
+
+// Arbitrary keys, smallest first.
+class HeapFrontier {
+ public:
+  void Push(int key, int cell) { heap_.push({key, cell}); }
+  auto Pop() -> int {
+    const int kCell = heap_.top().cell;
+    heap_.pop();
+    return kCell;
+  }
+  auto Empty() const -> bool { return heap_.empty(); }
+  auto Size() const -> size_t { return heap_.size(); }
+
+ private:
+  struct Entry {
+    int key;
+    int cell;
+  };
+  struct EntryAfter {
+    auto operator()(const Entry& left, const Entry& right) const -> bool {
+      return left.key > right.key;
+    }
+  };
+
+  std::priority_queue<Entry, std::vector<Entry>, EntryAfter> heap_;
+};
+
+// Monotone keys with arbitrary jumps, e.g. a whole corridor in one edge.
+class RadixFrontier {
+ public:
+  void Push(int key, int cell) {
+    heap_.Push(static_cast<std::uint32_t>(key), cell);
+  }
+  auto Pop() -> int { return heap_.Pop(); }
+  auto Empty() const -> bool { return heap_.Empty(); }
+  auto Size() const -> size_t { return heap_.Size(); }
+
+ private:
+  RadixHeap<int> heap_;
+};
+
+// A kRelaxCost policy that walks degree-2 runs inline (skip_corridors). A run
+// becomes one edge as long as the corridor, so keys still only grow (the
+// Manhattan heuristic stays consistent) but may jump by any amount.
+template <typename Policy>
+struct CorridorSkipping : Policy {
+  static_assert(Policy::kDiscovery == Discovery::kRelaxCost);
+  using Frontier = RadixFrontier;
+  static constexpr bool kSkipCorridors = true;
+};
+
+template <typename Policy>
+inline constexpr bool kSkipsCorridors =
+    requires { requires Policy::kSkipCorridors; };
+
+template <typename Policy>
+inline constexpr bool kHasGoalSet =
+    requires(const Policy& policy, int cell) { policy.IsGoal(cell); };
+
+// --- Flat search state back to the grid-shaped SearchResult. ---
+
+// True when `cell` continues its parent's step in the same direction; frames
+// in the middle of a straight run are skipped.
+inline auto ContinuesStraight(const std::vector<int>& parents, int cell)
+    -> bool {
+  const int kParent = parents[cell];
+  if (kParent == kNoCell) {
+    return false;
+  }
+  const int kGrandparent = parents[kParent];
+  return kGrandparent != kNoCell && cell - kParent == kParent - kGrandparent;
+}
+
+inline auto ToBoolGrid(const MazeAdjacency& adjacency,
+                       const std::vector<std::uint8_t>& cells) -> BoolGrid {
+  BoolGrid grid(static_cast<size_t>(adjacency.Height()));
+  const auto kWidth = static_cast<size_t>(adjacency.Width());
+  for (size_t row = 0; row < grid.size(); ++row) {
+    const auto kRowBegin = cells.begin() + static_cast<std::ptrdiff_t>(
+                                               row * kWidth);
+    grid[row].assign(kRowBegin,
+                     kRowBegin + static_cast<std::ptrdiff_t>(kWidth));
+  }
+  return grid;
+}
+
+inline auto ToParentGrid(const MazeAdjacency& adjacency,
+                         const std::vector<int>& parents) -> ParentGrid {
+  auto grid = CreateParentGrid(
+      {.height = adjacency.Height(), .width = adjacency.Width()},
+      kInvalidCell);
+  for (int index = 0; index < adjacency.CellCount(); ++index) {
+    if (parents[index] != kNoCell) {
+      const GridPosition kPos = adjacency.PositionOf(index);
+      grid[kPos.first][kPos.second] = adjacency.PositionOf(parents[index]);
+    }
+  }
+  return grid;
+}
+
+// Flat counterparts of ExtractParentPath and ClosestExploredCell.
+inline auto ExtractCellPath(const MazeAdjacency& adjacency,
+                            const std::vector<int>& parents, int start,
+                            int end) -> std::vector<GridPosition> {
+  std::vector<GridPosition> path;
+  for (int cell = end; cell != kNoCell; cell = parents[cell]) {
+    path.push_back(adjacency.PositionOf(cell));
+    if (cell == start) {
+      break;
+    }
+  }
+  std::ranges::reverse(path);
+  return path;
+}
+
+inline auto ClosestReachedCell(const MazeAdjacency& adjacency,
+                               const SearchState& state,
+                               const PathEndpoints& endpoints) -> int {
+  int closest = adjacency.IndexOf(endpoints.start);
+  int closest_distance =
+      ManhattanDistance({.first = endpoints.start, .second = endpoints.end});
+  for (int index = 0; index < adjacency.CellCount(); ++index) {
+    if (state.visited[index] != state.mark ||
+        state.parents[index] == kNoCell) {
+      continue;
+    }
+    const int kDistance = ManhattanDistance(
+        {.first = adjacency.PositionOf(index), .second = endpoints.end});
+    if (kDistance < closest_distance) {
+      closest_distance = kDistance;
+      closest = index;
+    }
+  }
+  return closest;
+}
+
+// --- Recorders: what a search leaves behind besides its path. ---
+
+// Visual-state grid plus the frames the renderer turns into images.
+class FrameRecorder {
+ public:
+  FrameRecorder(const MazeAdjacency& adjacency, const SearchBudget& budget,
+                SearchResult& result)
+      : adjacency_(adjacency),
+        visual_states_(CreateStateGrid(
+            {.height = adjacency.Height(), .width = adjacency.Width()},
+            SolverCellState::NONE)),
+        budget_(budget),
+        result_(result) {}
+
+  void Mark(int cell, SolverCellState state) {
+    const GridPosition kPos = adjacency_.PositionOf(cell);
+    visual_states_[kPos.first][kPos.second] = state;
+  }
+  auto WantsFrame(const std::vector<int>& parents, int current,
+                  CellEndpoints endpoints) const -> bool {
+    return current == endpoints.end || !ContinuesStraight(parents, current);
+  }
+  auto WantsBacktrackFrame(const std::vector<int>& parents, int current,
+                           CellEndpoints endpoints) const -> bool {
+    return current == endpoints.start || current == endpoints.end ||
+           !ContinuesStraight(parents, current);
+  }
+  void Frame() { RecordFrame(budget_, result_, visual_states_); }
+  void Finish(bool found, const PathEndpoints& endpoints,
+              SearchState&& state) {
+    FinalizeSearchResult(found, endpoints,
+                         ToParentGrid(adjacency_, state.parents),
+                         visual_states_, ToBoolGrid(adjacency_, state.visited),
+                         budget_, result_);
+  }
+
+ private:
+  const MazeAdjacency& adjacency_;
+  StateGrid visual_states_;
+  const SearchBudget& budget_;
+  SearchResult& result_;
+};
+
+// Path and explored cells only; every recording call compiles away. With
+// `compact_path` the path is run-length encoded from the parent links into
+// compact_path_, and no cell list is built.
+class NullRecorder {
+ public:
+  NullRecorder(const MazeAdjacency& adjacency, const SearchBudget& budget,
+               SearchResult& result, bool compact_path = false)
+      : adjacency_(adjacency),
+        budget_(budget),
+        result_(result),
+        compact_path_(compact_path) {}
+
+  void Mark(int /*cell*/, SolverCellState /*state*/) {}
+  auto WantsFrame(const std::vector<int>& /*parents*/, int /*current*/,
+                  CellEndpoints /*endpoints*/) const -> bool {
+    return false;
+  }
+  auto WantsBacktrackFrame(const std::vector<int>& /*parents*/,
+                           int /*current*/,
+                           CellEndpoints /*endpoints*/) const -> bool {
+    return false;
+  }
+  void Frame() {}
+  void Finish(bool found, const PathEndpoints& endpoints,
+              SearchState&& state) {
+    const int kStart = adjacency_.IndexOf(endpoints.start);
+    int path_end = kNoCell;
+    if (found) {
+      path_end = adjacency_.IndexOf(endpoints.end);
+    } else if (budget_.Stopped()) {
+      path_end = ClosestReachedCell(adjacency_, state, endpoints);
+    }
+    if (path_end != kNoCell && compact_path_) {
+      result_.compact_path_ = CompactPath::FromParents(
+          adjacency_.Width(), kStart, path_end,
+          [&state](int cell) -> int { return state.parents[cell]; });
+    } else if (path_end != kNoCell) {
+      result_.path_ =
+          ExtractCellPath(adjacency_, state.parents, kStart, path_end);
+    }
+    result_.found_ = found;
+    result_.explored_ = ToBoolGrid(adjacency_, state.visited);
+    SetTermination(budget_, result_);
+  }
+
+ private:
+  const MazeAdjacency& adjacency_;
+  const SearchBudget& budget_;
+  SearchResult& result_;
+  bool compact_path_;
+};
+
+// The search loop shared by BFS, DFS, Dijkstra, A* and Greedy Best-First.
+// `Policy` supplies:
+//   using Frontier;                 one of the frontiers above
+//   static constexpr Discovery kDiscovery;
+//   static constexpr std::array<int, kWallCount> kNeighborOrder;
+//   auto Key(int g_score, GridPosition cell, GridPosition end) -> int;
+// and optionally `static constexpr bool kSkipCorridors` (CorridorSkipping)
+// or `auto IsGoal(int cell) const -> bool`, which stops the search at the
+// first goal cell it expands instead of at the end (nearest of several
+// exits); endpoints.end then only feeds Key. The cell reached is left in
+// state.goal. Key is usually static; a policy whose heuristic needs data
+// (the landmark table) passes an instance as `policy`. Everything is
+// resolved at compile time, so each instantiation is a specialised kernel:
+// keys and recording inline, unused branches vanish.
+// Cells are MazeAdjacency indices and a NeighborTable lists each cell's open
+// neighbours, so expansion never bounds-checks or reads a wall.
+template <typename Policy, typename Recorder>
+auto RunSearch(const MazeAdjacency& adjacency, const PathEndpoints& endpoints,
+               SearchBudget& budget, Recorder& recorder, SearchState& state,
+               SearchStats& stats, const Policy& policy = {}) -> bool {
+  constexpr Discovery kDiscovery = Policy::kDiscovery;
+  const CellEndpoints kCells{.start = adjacency.IndexOf(endpoints.start),
+                             .end = adjacency.IndexOf(endpoints.end)};
+  const int kStart = kCells.start;
+  const int kEnd = kCells.end;
+  const NeighborTable kNeighbors(adjacency, Policy::kNeighborOrder);
+  auto& visited = state.visited;
+  auto& parents = state.parents;
+  const std::uint8_t kMark = state.mark;
+  const auto kIsGoal = [&policy, kEnd](int cell) -> bool {
+    if constexpr (kHasGoalSet<Policy>) {
+      return policy.IsGoal(cell);
+    } else {
+      return cell == kEnd;
+    }
+  };
+  const auto kKey = [&adjacency, &endpoints, &policy](int g_score,
+                                                     int cell) -> int {
+    return policy.Key(g_score, adjacency.PositionOf(cell), endpoints.end);
+  };
+
+  typename Policy::Frontier frontier;
+  const auto kPush = [&frontier, &stats](int key, int cell) -> void {
+    frontier.Push(key, cell);
+    ++stats.pushed_;
+    stats.peak_frontier_ = std::max(stats.peak_frontier_, frontier.Size());
+  };
+  parents[kStart] = kNoCell;
+  kPush(kKey(0, kStart), kStart);
+  if constexpr (kDiscovery == Discovery::kMarkOnPush) {
+    visited[kStart] = kMark;
+  }
+  recorder.Mark(kStart, SolverCellState::FRONTIER);
+  recorder.Frame();
+
+  if constexpr (kDiscovery == Discovery::kDepthFirst) {
+    while (!frontier.Empty()) {
+      const int kCurrent = frontier.Top();
+      if (visited[kCurrent] != kMark) {
+        if (!budget.Spend()) {
+          return false;
+        }
+        visited[kCurrent] = kMark;
+        recorder.Mark(kCurrent, SolverCellState::CURRENT_PROC);
+        if (recorder.WantsFrame(parents, kCurrent, kCells)) {
+          recorder.Frame();
+        }
+      }
+      if (kIsGoal(kCurrent)) {
+        state.goal = kCurrent;
+        return true;
+      }
+
+      bool pushed = false;
+      for (const int kOffset : kNeighbors.Of(kCurrent)) {
+        const int kNext = kCurrent + kOffset;
+        if (visited[kNext] != kMark) {
+          parents[kNext] = kCurrent;
+          kPush(0, kNext);
+          recorder.Mark(kNext, SolverCellState::FRONTIER);
+          pushed = true;
+          break;
+        }
+      }
+      if (!pushed) {
+        frontier.Pop();
+        recorder.Mark(kCurrent, SolverCellState::VISITED_PROC);
+        if (recorder.WantsBacktrackFrame(parents, kCurrent, kCells)) {
+          recorder.Frame();
+        }
+      }
+    }
+    return false;
+  } else {
+    auto& reached = state.reached;
+    auto& g_scores = state.g_scores;
+    if constexpr (kDiscovery != Discovery::kMarkOnPush) {
+      if (reached.size() != visited.size()) {
+        reached.assign(visited.size(), 0);
+      }
+      reached[kStart] = kMark;
+    }
+    if constexpr (kDiscovery == Discovery::kRelaxCost) {
+      if (g_scores.size() != visited.size()) {
+        g_scores.resize(visited.size());
+      }
+      g_scores[kStart] = 0;
+    }
+
+    while (!frontier.Empty()) {
+      const int kCurrent = frontier.Pop();
+      if constexpr (kDiscovery != Discovery::kMarkOnPush) {
+        if (visited[kCurrent] == kMark) {
+          ++stats.stale_pops_;
+          continue;
+        }
+      }
+      if (!budget.Spend()) {
+        return false;
+      }
+
+      const bool kShouldSaveFrame =
+          recorder.WantsFrame(parents, kCurrent, kCells);
+      visited[kCurrent] = kMark;
+      recorder.Mark(kCurrent, SolverCellState::CURRENT_PROC);
+      if (kShouldSaveFrame) {
+        recorder.Frame();
+      }
+      if (kIsGoal(kCurrent)) {
+        state.goal = kCurrent;
+        return true;
+      }
+
+      for (const int kOffset : kNeighbors.Of(kCurrent)) {
+        const int kNext = kCurrent + kOffset;
+        if (visited[kNext] == kMark) {
+          continue;
+        }
+        if constexpr (kDiscovery == Discovery::kMarkOnPush) {
+          visited[kNext] = kMark;
+          parents[kNext] = kCurrent;
+          kPush(0, kNext);
+        } else if constexpr (kDiscovery == Discovery::kRelaxCost) {
+          // Unreached cells count as infinitely far.
+          const auto kGScore = [&reached, &g_scores, kMark](int cell) -> int {
+            return reached[cell] == kMark
+                       ? g_scores[cell]
+                       : std::numeric_limits<int>::max() / kMaxCostDivisor;
+          };
+          int tentative_g = g_scores[kCurrent] + 1;
+          int from = kCurrent;
+          int cell = kNext;
+          if constexpr (kSkipsCorridors<Policy>) {
+            // Corridor cells get g-scores and parents but stay open, so a
+            // shorter way in through the far end can still improve them.
+            while (!kIsGoal(cell) && tentative_g < kGScore(cell)) {
+              const auto& corridor = kNeighbors.Of(cell);
+              if (corridor.count != 2) {
+                break;
+              }
+              const int kExit = cell + corridor.offsets[0] == from
+                                    ? cell + corridor.offsets[1]
+                                    : cell + corridor.offsets[0];
+              reached[cell] = kMark;
+              g_scores[cell] = tentative_g;
+              parents[cell] = from;
+              recorder.Mark(cell, SolverCellState::VISITED_PROC);
+              ++stats.skipped_;
+              from = cell;
+              cell = kExit;
+              ++tentative_g;
+            }
+          }
+          if (tentative_g >= kGScore(cell)) {
+            continue;
+          }
+          reached[cell] = kMark;
+          g_scores[cell] = tentative_g;
+          parents[cell] = from;
+          kPush(kKey(tentative_g, cell), cell);
+          recorder.Mark(cell, SolverCellState::FRONTIER);
+          continue;
+        } else {
+          if (reached[kNext] != kMark) {
+            reached[kNext] = kMark;
+            parents[kNext] = kCurrent;
+          }
+          kPush(kKey(0, kNext), kNext);
+        }
+        recorder.Mark(kNext, SolverCellState::FRONTIER);
+      }
+
+      recorder.Mark(kCurrent, SolverCellState::VISITED_PROC);
+      if (kShouldSaveFrame) {
+        recorder.Frame();
+      }
+    }
+    return false;
+  }
+}
+
+// Validates the query, then runs Policy with frames (options.record_frames)
+// or without.
+template <typename Policy>
+auto SolveWithPolicy(const MazeGrid& maze_grid, GridPosition start_node,
+                     GridPosition end_node, const SolveOptions& options,
+                     const Policy& policy = {}) -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  const PathEndpoints kEndpoints{.start = start_node, .end = end_node};
+  const MazeAdjacency kAdjacency(maze_grid);
+  const auto kCellCount = static_cast<size_t>(kAdjacency.CellCount());
+  SearchResult result;
+  SearchBudget budget(options);
+  SearchState state;
+  state.Begin(kAdjacency.CellCount());
+  const auto kRun = [&]<typename Recorder>(Recorder recorder) -> void {
+    const bool kFound =
+        RunSearch<Policy>(kAdjacency, kEndpoints, budget, recorder, state,
+                          result.stats_, policy);
+    if constexpr (kSkipsCorridors<Policy>) {
+      // Skipped corridor cells were reached without being expanded.
+      for (size_t index = 0; index < kCellCount; ++index) {
+        if (state.reached[index] == state.mark) {
+          state.visited[index] = state.mark;
+        }
+      }
+    }
+    recorder.Finish(kFound, kEndpoints, std::move(state));
+  };
+  if (options.record_frames) {
+    kRun(FrameRecorder(kAdjacency, budget, result));
+  } else {
+    kRun(NullRecorder(kAdjacency, budget, result, options.compact_path));
+  }
+  return result;
+}
+
+}  // namespace MazeSolverDomain::detail
+
+#endif  // MAZE_DOMAIN_MAZE_SEARCH_KERNEL_H
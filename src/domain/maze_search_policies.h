@@ -0,0 +1,90 @@
+#ifndef MAZE_DOMAIN_MAZE_SEARCH_POLICIES_H
+#define MAZE_DOMAIN_MAZE_SEARCH_POLICIES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+#include "domain/maze_landmarks.h"
+#include "domain/maze_search_kernel.h"
+
+namespace MazeSolverDomain::detail {
+
+// The RunSearch policies behind Solve(); SolveBatch() runs the same ones, so a
+// batch answer is the path Solve() reports for that pair.
+
+struct BreadthFirstPolicy {
+  using Frontier = FifoFrontier;
+  static constexpr Discovery kDiscovery = Discovery::kMarkOnPush;
+  static constexpr auto kNeighborOrder = kQueueNeighborOrder;
+  static auto Key(int /*g_score*/, GridPosition /*cell*/,
+                  GridPosition /*end*/) -> int {
+    return 0;
+  }
+};
+
+struct DepthFirstPolicy {
+  using Frontier = LifoFrontier;
+  static constexpr Discovery kDiscovery = Discovery::kDepthFirst;
+  static constexpr auto kNeighborOrder = kStackNeighborOrder;
+  static auto Key(int /*g_score*/, GridPosition /*cell*/,
+                  GridPosition /*end*/) -> int {
+    return 0;
+  }
+};
+
+// Every passage costs 1, so pushed keys never exceed the popped key + 1.
+struct DijkstraPolicy {
+  using Frontier = BucketFrontier<1>;
+  static constexpr Discovery kDiscovery = Discovery::kRelaxCost;
+  static constexpr auto kNeighborOrder = kQueueNeighborOrder;
+  static auto Key(int g_score, GridPosition /*cell*/, GridPosition /*end*/)
+      -> int {
+    return g_score;
+  }
+};
+
+// With unit passages and the Manhattan heuristic a neighbour's f-score is the
+// current f-score or 2 more.
+struct AStarPolicy {
+  using Frontier = BucketFrontier<2>;
+  static constexpr Discovery kDiscovery = Discovery::kRelaxCost;
+  static constexpr auto kNeighborOrder = kQueueNeighborOrder;
+  static auto Key(int g_score, GridPosition cell, GridPosition end) -> int {
+    return g_score + ManhattanDistance({.first = cell, .second = end});
+  }
+};
+
+// Heuristic-only keys can drop between steps, so Greedy needs a real heap.
+struct GreedyBestFirstPolicy {
+  using Frontier = HeapFrontier;
+  static constexpr Discovery kDiscovery = Discovery::kFirstParent;
+  static constexpr auto kNeighborOrder = kQueueNeighborOrder;
+  static auto Key(int /*g_score*/, GridPosition cell, GridPosition end)
+      -> int {
+    return ManhattanDistance({.first = cell, .second = end});
+  }
+};
+
+// AStarPolicy with the landmark bound folded into the heuristic. The max of
+// two consistent heuristics is consistent, and on the bipartite grid both
+// change by exactly 1 per step, so f-scores still grow by 0 or 2.
+struct LandmarkAStarPolicy {
+  using Frontier = BucketFrontier<2>;
+  static constexpr Discovery kDiscovery = Discovery::kRelaxCost;
+  static constexpr auto kNeighborOrder = kQueueNeighborOrder;
+
+  auto Key(int g_score, GridPosition cell, GridPosition end) const -> int {
+    const int kCell = (cell.first * landmarks->Width()) + cell.second;
+    return g_score +
+           std::max(ManhattanDistance({.first = cell, .second = end}),
+                    landmarks->LowerBound(kCell, target));
+  }
+
+  const LandmarkTable* landmarks = nullptr;
+  std::span<const std::uint32_t> target;
+};
+
+}  // namespace MazeSolverDomain::detail
+
+#endif  // MAZE_DOMAIN_MAZE_SEARCH_POLICIES_H
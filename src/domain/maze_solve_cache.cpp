@@ -0,0 +1,191 @@
+#include "domain/maze_solve_cache.h"
+
+#include <utility>
+
+namespace MazeSolverDomain {
+
+namespace {
+
+// splitmix64 finalizer.
+auto Mix(std::uint64_t value) -> std::uint64_t {
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31;
+  return value;
+}
+
+auto Combine(std::uint64_t hash, std::uint64_t value) -> std::uint64_t {
+  return Mix(hash ^ (value + 0x9E3779B97F4A7C15ULL + (hash << 6)));
+}
+
+auto PositionBits(GridPosition pos) -> std::uint64_t {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.first))
+          << 32) |
+         static_cast<std::uint32_t>(pos.second);
+}
+
+}  // namespace
+
+auto SolveCacheKey::Hash() const -> std::uint64_t {
+  std::uint64_t hash = Combine(maze_, options_);
+  hash = Combine(hash, PositionBits(start_));
+  hash = Combine(hash, PositionBits(end_));
+  return Combine(hash, static_cast<std::uint64_t>(algorithm_));
+}
+
+auto MazeFingerprint(const MazeDomain::MazeGrid& maze_grid) -> std::uint64_t {
+  const size_t kWidth = maze_grid.empty() ? 0 : maze_grid.front().size();
+  std::uint64_t hash = Combine(maze_grid.size(), kWidth);
+  for (const auto& row : maze_grid) {
+    std::uint64_t word = 0;
+    size_t shift = 0;
+    for (const auto& cell : row) {
+      const std::uint64_t kNibble =
+          static_cast<std::uint64_t>(cell.walls[0]) |
+          (static_cast<std::uint64_t>(cell.walls[1]) << 1U) |
+          (static_cast<std::uint64_t>(cell.walls[2]) << 2U) |
+          (static_cast<std::uint64_t>(cell.walls[3]) << 3U);
+      word |= kNibble << shift;
+      shift += 4;
+      if (shift == 64) {
+        hash = Combine(hash, word);
+        word = 0;
+        shift = 0;
+      }
+    }
+    // Rows end on a word, so a ragged grid cannot alias a rectangular one.
+    hash = Combine(hash, word ^ row.size());
+  }
+  return hash;
+}
+
+auto MakeSolveCacheKey(std::uint64_t maze_fingerprint, GridPosition start_node,
+                       GridPosition end_node,
+                       SolverAlgorithmType algorithm_type,
+                       const SolveOptions& options) -> SolveCacheKey {
+  std::uint64_t options_hash = Combine(0, options.max_expanded_nodes);
+  options_hash = Combine(options_hash, options.max_frames);
+  options_hash =
+      Combine(options_hash, static_cast<std::uint64_t>(options.landmark_count));
+  options_hash =
+      Combine(options_hash, static_cast<std::uint64_t>(options.cluster_size));
+  options_hash = Combine(options_hash, options.search_threads);
+  options_hash = Combine(
+      options_hash, static_cast<std::uint64_t>(options.record_frames) |
+                        (static_cast<std::uint64_t>(options.skip_corridors)
+                         << 1U) |
+                        (static_cast<std::uint64_t>(options.prefilter_dead_ends)
+                         << 2U) |
+                        (static_cast<std::uint64_t>(options.compact_path)
+                         << 3U) |
+                        // Inverted, so keys saved before the flag still match.
+                        (static_cast<std::uint64_t>(!options.allow_bitboard_bfs)
+                         << 4U));
+  return {.maze_ = maze_fingerprint,
+          .options_ = options_hash,
+          .start_ = start_node,
+          .end_ = end_node,
+          .algorithm_ = algorithm_type};
+}
+
+auto IsCacheable(const SearchResult& result) -> bool {
+  return result.termination_ == SearchTermination::COMPLETED;
+}
+
+auto CachedBytes(const SearchResult& result) -> size_t {
+  size_t bytes = sizeof(SearchResult) + result.stats_.frame_bytes_ +
+                 (result.frames_.size() * sizeof(SearchFrame)) +
+                 (result.path_.size() * sizeof(GridPosition)) +
+                 result.compact_path_.Bytes();
+  for (const auto& row : result.explored_) {
+    bytes += sizeof(row) + (row.size() / 8);
+  }
+  return bytes;
+}
+
+void SolveCache::SetCapacity(size_t capacity, size_t max_bytes) {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  capacity_ = capacity;
+  max_bytes_ = max_bytes;
+  EvictOverCapacity();
+}
+
+auto SolveCache::Capacity() const -> size_t {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  return capacity_;
+}
+
+auto SolveCache::MaxBytes() const -> size_t {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  return max_bytes_;
+}
+
+auto SolveCache::Find(const SolveCacheKey& key)
+    -> std::shared_ptr<const SearchResult> {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  const auto kIt = index_.find(key);
+  if (kIt == index_.end()) {
+    ++stats_.misses_;
+    return nullptr;
+  }
+  ++stats_.hits_;
+  entries_.splice(entries_.begin(), entries_, kIt->second);
+  return kIt->second->result;
+}
+
+void SolveCache::RecordDiskHit() {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  if (stats_.misses_ > 0) {
+    --stats_.misses_;
+    ++stats_.disk_hits_;
+  }
+}
+
+void SolveCache::Insert(const SolveCacheKey& key, SearchResult result) {
+  if (!IsCacheable(result)) {
+    return;
+  }
+  const size_t kBytes = CachedBytes(result);
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  if (capacity_ == 0) {
+    return;
+  }
+  if (max_bytes_ != 0 && kBytes > max_bytes_) {
+    ++stats_.too_large_;
+    return;
+  }
+  auto shared = std::make_shared<const SearchResult>(std::move(result));
+  const auto kIt = index_.find(key);
+  if (kIt != index_.end()) {
+    stats_.bytes_ -= kIt->second->bytes;
+    kIt->second->result = std::move(shared);
+    kIt->second->bytes = kBytes;
+    entries_.splice(entries_.begin(), entries_, kIt->second);
+  } else {
+    entries_.push_front(
+        {.key = key, .result = std::move(shared), .bytes = kBytes});
+    index_.emplace(key, entries_.begin());
+  }
+  stats_.bytes_ += kBytes;
+  ++stats_.stores_;
+  EvictOverCapacity();
+}
+
+auto SolveCache::Stats() const -> SolveCacheStats {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+  return stats_;
+}
+
+void SolveCache::EvictOverCapacity() {
+  while (entries_.size() > capacity_ ||
+         (max_bytes_ != 0 && stats_.bytes_ > max_bytes_)) {
+    stats_.bytes_ -= entries_.back().bytes;
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++stats_.evictions_;
+  }
+}
+
+}  // namespace MazeSolverDomain
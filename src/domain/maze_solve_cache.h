@@ -0,0 +1,112 @@
+#ifndef MAZE_DOMAIN_MAZE_SOLVE_CACHE_H
+#define MAZE_DOMAIN_MAZE_SOLVE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+// Everything a cached SearchResult depends on. options_ hashes the
+// SolveOptions that change the result (frames, node limit, solver knobs);
+// the deadline and stop token do not, as only completed results are stored.
+struct SolveCacheKey {
+  std::uint64_t maze_ = 0;
+  std::uint64_t options_ = 0;
+  GridPosition start_ = {0, 0};
+  GridPosition end_ = {0, 0};
+  SolverAlgorithmType algorithm_ = SolverAlgorithmType::BFS;
+
+  auto operator==(const SolveCacheKey& other) const -> bool = default;
+  // Mix of all fields, also used to name cache files.
+  auto Hash() const -> std::uint64_t;
+};
+
+struct SolveCacheKeyHash {
+  auto operator()(const SolveCacheKey& key) const -> size_t {
+    return static_cast<size_t>(key.Hash());
+  }
+};
+
+struct SolveCacheStats {
+  size_t hits_ = 0;
+  // Lookups missed in memory but answered by a persisted result.
+  size_t disk_hits_ = 0;
+  size_t misses_ = 0;
+  size_t stores_ = 0;
+  size_t evictions_ = 0;
+  // Results bigger than the whole byte budget, never stored.
+  size_t too_large_ = 0;
+  // Approximate memory held by the stored results (see CachedBytes).
+  size_t bytes_ = 0;
+};
+
+// 64-bit hash of the grid's size and walls, packed 16 cells (4 wall bits
+// each) per word and mixed a word at a time.
+std::uint64_t MazeFingerprint(const MazeDomain::MazeGrid& maze_grid);
+
+SolveCacheKey MakeSolveCacheKey(std::uint64_t maze_fingerprint,
+                                GridPosition start_node, GridPosition end_node,
+                                SolverAlgorithmType algorithm_type,
+                                const SolveOptions& options);
+
+// Results stopped by a limit depend on timing and are never stored.
+bool IsCacheable(const SearchResult& result);
+
+// Approximate memory a cached result holds: its frames, path and explored
+// grid. Recorded searches are dominated by their frames.
+size_t CachedBytes(const SearchResult& result);
+
+// In-memory LRU of solve results holding at most `capacity` entries and, when
+// `max_bytes` is not 0, at most that many CachedBytes in total. Entries are
+// shared and immutable, so a hit copies the result outside the lock. Safe to
+// use from several threads.
+class SolveCache {
+ public:
+  explicit SolveCache(size_t capacity, size_t max_bytes = 0)
+      : capacity_(capacity), max_bytes_(max_bytes) {}
+
+  // Shrinking evicts the least recently used entries; a capacity of 0
+  // empties the cache and turns Insert into a no-op.
+  void SetCapacity(size_t capacity, size_t max_bytes);
+  auto Capacity() const -> size_t;
+  auto MaxBytes() const -> size_t;
+
+  // Counts a hit or a miss and marks the entry most recently used.
+  auto Find(const SolveCacheKey& key) -> std::shared_ptr<const SearchResult>;
+  // Turns the last miss into a disk hit.
+  void RecordDiskHit();
+  // Stores `result` if IsCacheable() and it fits the byte budget; replaces an
+  // entry with the same key.
+  void Insert(const SolveCacheKey& key, SearchResult result);
+  auto Stats() const -> SolveCacheStats;
+
+ private:
+  struct Entry {
+    SolveCacheKey key;
+    std::shared_ptr<const SearchResult> result;
+    size_t bytes = 0;
+  };
+
+  void EvictOverCapacity();
+
+  mutable std::mutex mutex_;
+  size_t capacity_ = 0;
+  size_t max_bytes_ = 0;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<SolveCacheKey, std::list<Entry>::iterator,
+                     SolveCacheKeyHash>
+      index_;
+  SolveCacheStats stats_;
+};
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_SOLVE_CACHE_H
@@ -1,22 +1,60 @@
 #include "domain/maze_solver.h"
 
 #include <cctype>
+#include <chrono>
 
+#include "domain/maze_adjacency.h"
+#include "domain/maze_dead_end_filler.h"
 #include "domain/maze_solver_algorithms.h"
 
 namespace MazeSolverDomain {
 
 using MazeGrid = MazeDomain::MazeGrid;
 
+namespace {
+
+auto FrameBytes(const std::vector<SearchFrame>& frames) -> size_t {
+  size_t bytes = 0;
+  for (const auto& frame : frames) {
+    for (const auto& row : frame.visual_states_) {
+      bytes += row.size() * sizeof(SolverCellState);
+    }
+    bytes += frame.current_path_.size() * sizeof(GridPosition);
+  }
+  return bytes;
+}
+
+}  // namespace
+
 MazeSolverFactory::MazeSolverFactory() {
   RegisterSolver(SolverAlgorithmType::BFS, "BFS", detail::SolveBfs);
+  RegisterSolver(SolverAlgorithmType::BITBOARD_BFS, "Bitboard BFS",
+                 detail::SolveBitboardBfs);
   RegisterSolver(SolverAlgorithmType::DFS, "DFS", detail::SolveDfs);
   RegisterSolver(SolverAlgorithmType::ASTAR, "AStar", detail::SolveAStar);
+  RegisterSolver(SolverAlgorithmType::PARALLEL_ASTAR, "Parallel AStar",
+                 detail::SolveParallelAStar);
   RegisterSolver(SolverAlgorithmType::DIJKSTRA, "Dijkstra",
                  detail::SolveDijkstra);
   RegisterSolver(SolverAlgorithmType::GREEDY_BEST_FIRST, "Greedy Best-First",
                  detail::SolveGreedyBestFirst);
+  RegisterSolver(SolverAlgorithmType::JUNCTION_GRAPH, "Junction Graph",
+                 detail::SolveJunctionGraph);
+  RegisterSolver(SolverAlgorithmType::TREE_LCA, "Tree LCA",
+                 detail::SolveTreeLca);
+  RegisterSolver(SolverAlgorithmType::HIERARCHICAL, "Hierarchical",
+                 detail::SolveHierarchical);
+  RegisterSolver(SolverAlgorithmType::DEAD_END_FILLING, "Dead-End Filling",
+                 detail::SolveDeadEndFilling);
+  RegisterSolver(SolverAlgorithmType::WALL_FOLLOWER, "Wall Follower",
+                 detail::SolveWallFollower);
+  RegisterSolver(SolverAlgorithmType::TREMAUX, "Tremaux",
+                 detail::SolveTremaux);
   name_to_type_["A*"] = SolverAlgorithmType::ASTAR;
+  name_to_type_["PARALLEL A*"] = SolverAlgorithmType::PARALLEL_ASTAR;
+  name_to_type_["HDA*"] = SolverAlgorithmType::PARALLEL_ASTAR;
+  name_to_type_["HPA*"] = SolverAlgorithmType::HIERARCHICAL;
+  name_to_type_["DEAD END FILLING"] = SolverAlgorithmType::DEAD_END_FILLING;
 }
 
 auto MazeSolverFactory::Instance() -> MazeSolverFactory& {
@@ -26,7 +64,7 @@ auto MazeSolverFactory::Instance() -> MazeSolverFactory& {
 
 void MazeSolverFactory::RegisterSolver(SolverAlgorithmType type,
                                        std::string name, Solver solver) {
-  registry_[type] = Entry{.name = std::move(name), .solver = std::move(solver)};
+  registry_[type] = Entry{.name = std::move(name), .solver = solver};
 
   std::string key;
   key.reserve(registry_[type].name.size());
@@ -46,7 +84,7 @@ auto MazeSolverFactory::GetSolver(SolverAlgorithmType type) const
   if (iterator != registry_.end()) {
     return iterator->second.solver;
   }
-  return {};
+  return nullptr;
 }
 
 auto MazeSolverFactory::NameFor(SolverAlgorithmType type) const -> std::string {
@@ -82,8 +120,14 @@ auto MazeSolverFactory::Names() const -> std::vector<std::string> {
 }
 
 auto Solve(const MazeGrid& maze_grid, GridPosition start_node,
-           GridPosition end_node, SolverAlgorithmType algorithm_type)
-    -> SearchResult {
+           GridPosition end_node, SolverAlgorithmType algorithm_type,
+           const SolveOptions& options) -> SearchResult {
+  const auto kStartTime = std::chrono::steady_clock::now();
+  if (algorithm_type == SolverAlgorithmType::BFS && !options.record_frames &&
+      !options.skip_corridors && options.allow_bitboard_bfs &&
+      detail::FavorsBitboardBfs(maze_grid)) {
+    algorithm_type = SolverAlgorithmType::BITBOARD_BFS;
+  }
   auto solver = MazeSolverFactory::Instance().GetSolver(algorithm_type);
   if (!solver) {
     solver = MazeSolverFactory::Instance().GetSolver(SolverAlgorithmType::BFS);
@@ -91,13 +135,48 @@ auto Solve(const MazeGrid& maze_grid, GridPosition start_node,
   if (!solver) {
     return {};
   }
-  return solver(maze_grid, start_node, end_node);
+  SearchResult result;
+  if (options.prefilter_dead_ends &&
+      algorithm_type != SolverAlgorithmType::DEAD_END_FILLING) {
+    const DeadEndFill kFill =
+        FillDeadEnds(MazeAdjacency(maze_grid), start_node, end_node);
+    MazeGrid filled_grid = maze_grid;
+    SealFilledCells(filled_grid, kFill);
+    result = solver(filled_grid, start_node, end_node, options);
+    result.stats_.filled_ = kFill.filled_;
+  } else {
+    result = solver(maze_grid, start_node, end_node, options);
+  }
+  if (options.compact_path && !result.path_.empty()) {
+    result.compact_path_ = CompactPath::FromPath(result.path_);
+    result.path_ = {};
+  }
+  result.stats_.seconds_ = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - kStartTime)
+                               .count() -
+                           result.stats_.preprocess_seconds_;
+  result.stats_.frames_recorded_ = result.frames_.size();
+  result.stats_.frame_bytes_ = FrameBytes(result.frames_);
+  return result;
 }
 
 auto AlgorithmName(SolverAlgorithmType algorithm_type) -> std::string {
   return MazeSolverFactory::Instance().NameFor(algorithm_type);
 }
 
+auto TerminationName(SearchTermination termination) -> std::string_view {
+  switch (termination) {
+    case SearchTermination::NODE_LIMIT:
+      return "node limit";
+    case SearchTermination::DEADLINE:
+      return "deadline";
+    case SearchTermination::CANCELLED:
+      return "cancelled";
+    default:
+      return "completed";
+  }
+}
+
 auto TryParseAlgorithm(std::string_view name, SolverAlgorithmType& out_type)
     -> bool {
   return MazeSolverFactory::Instance().TryParse(name, out_type);
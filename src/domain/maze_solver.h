@@ -1,20 +1,38 @@
 #ifndef MAZE_DOMAIN_MAZE_SOLVER_H
 #define MAZE_DOMAIN_MAZE_SOLVER_H
 
-#include <functional>
+#include <chrono>
+#include <cstddef>
 #include <map>
+#include <optional>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "domain/maze_compact_path.h"
 #include "domain/maze_grid.h"
 
 namespace MazeSolverDomain {
 
 using GridPosition = std::pair<int, int>;
 
-enum class SolverAlgorithmType { BFS, DFS, ASTAR, DIJKSTRA, GREEDY_BEST_FIRST };
+enum class SolverAlgorithmType {
+  BFS,
+  BITBOARD_BFS,
+  DFS,
+  ASTAR,
+  PARALLEL_ASTAR,
+  DIJKSTRA,
+  GREEDY_BEST_FIRST,
+  JUNCTION_GRAPH,
+  TREE_LCA,
+  HIERARCHICAL,
+  DEAD_END_FILLING,
+  WALL_FOLLOWER,
+  TREMAUX
+};
 
 enum class SolverCellState {
   NONE,
@@ -26,23 +44,126 @@ enum class SolverCellState {
   SOLUTION
 };
 
+enum class SearchTermination { COMPLETED, NODE_LIMIT, DEADLINE, CANCELLED };
+
+class ClusterGraph;
+class JunctionGraph;
+class LandmarkTable;
+class TreePathIndex;
+
+// Bounds for a single search; zero limits mean "unlimited". max_frames only
+// caps the frames recorded while searching (the final frame is always
+// added), it never stops the search.
+struct SolveOptions {
+  size_t max_expanded_nodes = 0;
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+  std::stop_token stop_token;
+  size_t max_frames = 0;
+  // false skips the visual states and frames entirely; only path_,
+  // explored_ and the termination fields are filled in.
+  bool record_frames = true;
+  // BFS, Dijkstra and A* walk degree-2 runs inline and queue only the
+  // junction, dead end or goal at their far end. Paths stay the same length;
+  // the other solvers ignore it.
+  bool skip_corridors = false;
+  // false keeps BFS on the queue BFS even where Solve() would run it as
+  // BITBOARD_BFS, e.g. to check the bitboard solver against it.
+  bool allow_bitboard_bfs = true;
+  // A* builds a LandmarkTable with this many landmarks and adds the ALT
+  // bound to its heuristic; 0 keeps plain Manhattan. The table is built per
+  // Solve() call, timed as preprocess_seconds_, unless `landmarks` is set;
+  // SolveBatch() builds one for all its queries.
+  int landmark_count = 0;
+  // Prebuilt table for this maze, used by A* instead of building one; the
+  // caller keeps it alive for the call. A table for another grid size falls
+  // back to plain A*.
+  const LandmarkTable* landmarks = nullptr;
+  // Cluster edge length of the HIERARCHICAL solver; 0 uses
+  // ClusterGraph::kDefaultClusterSize. The graph is built per Solve() call,
+  // timed as preprocess_seconds_, unless `cluster_graph` is set.
+  int cluster_size = 0;
+  // Prebuilt graph for this maze, used by HIERARCHICAL when its grid size
+  // and cluster edge match; the caller keeps it alive for the call.
+  const ClusterGraph* cluster_graph = nullptr;
+  // Prebuilt graph for this maze, used by JUNCTION_GRAPH when its grid size
+  // matches; otherwise one is built per Solve() call, timed as
+  // preprocess_seconds_.
+  const JunctionGraph* junction_graph = nullptr;
+  // TreePathIndex::Build() of this maze, used by TREE_LCA when its grid size
+  // matches; an empty optional records that the maze is not a tree, so the
+  // BFS fallback runs without trying again. Otherwise the index is built per
+  // Solve() call, timed as preprocess_seconds_.
+  const std::optional<TreePathIndex>* tree_index = nullptr;
+  // Workers of the PARALLEL_ASTAR solver; 0 uses
+  // std::thread::hardware_concurrency().
+  unsigned search_threads = 0;
+  // Solve() seals every dead end (FillDeadEnds) before running the solver,
+  // so it only searches the cells that can lie on a start -> end path. The
+  // fill is counted in seconds_; the DEAD_END_FILLING solver ignores it.
+  bool prefilter_dead_ends = false;
+  // Results carry the path as compact_path_ and leave path_ empty. Searches
+  // on the shared kernel encode it straight from their parent links when no
+  // frames are recorded; other solvers' paths are encoded afterwards.
+  bool compact_path = false;
+};
+
 struct SearchFrame {
   std::vector<std::vector<SolverCellState>> visual_states_;
   std::vector<GridPosition> current_path_;
 };
 
+// Per-run counters. Solvers without a frontier (index lookups, walkers)
+// leave the frontier counters at zero.
+struct SearchStats {
+  size_t expanded_ = 0;
+  size_t pushed_ = 0;
+  // Pops of cells that were already expanded through a cheaper entry.
+  size_t stale_pops_ = 0;
+  size_t peak_frontier_ = 0;
+  // Corridor cells passed inline by SolveOptions::skip_corridors.
+  size_t skipped_ = 0;
+  // Landmark table behind an ALT heuristic, zero without one.
+  size_t landmarks_ = 0;
+  size_t landmark_bytes_ = 0;
+  // Cells sealed by dead-end filling, as a solver or as a prefilter.
+  size_t filled_ = 0;
+  size_t frames_recorded_ = 0;
+  size_t frame_bytes_ = 0;
+  // Wall-clock time of Solve() alone, frame recording included and
+  // preprocess_seconds_ excluded.
+  double seconds_ = 0.0;
+  // Per-maze tables (landmarks, cluster or junction graph, tree index) built
+  // inside the call.
+  double preprocess_seconds_ = 0.0;
+  // Answered by the solve cache: the counters above are those of the
+  // original search, and both times are zero.
+  bool from_cache_ = false;
+};
+
 struct SearchResult {
   bool found_ = false;
   std::vector<GridPosition> path_;
   std::vector<std::vector<bool>> explored_;
   std::vector<SearchFrame> frames_;
+  // Anything but COMPLETED leaves found_ false, with path_ running from the
+  // start to the explored cell closest (Manhattan) to the end.
+  SearchTermination termination_ = SearchTermination::COMPLETED;
+  SearchStats stats_;
+  // Filled instead of path_ under SolveOptions::compact_path.
+  CompactPath compact_path_;
+
+  auto PathCells() const -> size_t {
+    return compact_path_.Empty() ? path_.size() : compact_path_.CellCount();
+  }
 };
 
 class MazeSolverFactory {
  public:
-  using Solver = std::function<SearchResult(const MazeDomain::MazeGrid&,
-                                            GridPosition start_node,
-                                            GridPosition end_node)>;
+  using Solver = SearchResult (*)(const MazeDomain::MazeGrid& maze_grid,
+                                  GridPosition start_node,
+                                  GridPosition end_node,
+                                  const SolveOptions& options);
 
   static MazeSolverFactory& Instance();
 
@@ -59,17 +180,23 @@ class MazeSolverFactory {
 
   struct Entry {
     std::string name;
-    Solver solver;
+    Solver solver = nullptr;
   };
 
   std::map<SolverAlgorithmType, Entry> registry_;
   std::map<std::string, SolverAlgorithmType> name_to_type_;
 };
 
+// Solve() runs BFS queries as BITBOARD_BFS when neither frames nor
+// skip_corridors are asked for, options.allow_bitboard_bfs is set and the
+// maze is narrow and loop-rich enough for it to be faster (see
+// detail::FavorsBitboardBfs).
 SearchResult Solve(const MazeDomain::MazeGrid& maze_grid,
                    GridPosition start_node, GridPosition end_node,
-                   SolverAlgorithmType algorithm_type);
+                   SolverAlgorithmType algorithm_type,
+                   const SolveOptions& options = {});
 std::string AlgorithmName(SolverAlgorithmType algorithm_type);
+std::string_view TerminationName(SearchTermination termination);
 bool TryParseAlgorithm(std::string_view name, SolverAlgorithmType& out_type);
 std::vector<std::string> supported_algorithms();
 
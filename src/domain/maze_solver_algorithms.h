@@ -6,15 +6,62 @@
 namespace MazeSolverDomain::detail {
 
 auto SolveBfs(const MazeGrid& maze_grid, GridPosition start_node,
-              GridPosition end_node) -> SearchResult;
+              GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+// Widest maze whose rows fit one bitboard word.
+inline constexpr int kBitboardMaxWidth = 64;
+
+// BFS over row bitboards: every level advances the whole frontier with
+// shifts and masks, one word per row, and the path is rebuilt backwards from
+// per-level snapshots of the frontier rows. Same path length as SolveBfs;
+// frames are one per level. Wider mazes go to SolveBfs.
+auto SolveBitboardBfs(const MazeGrid& maze_grid, GridPosition start_node,
+                      GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+// Whether SolveBitboardBfs is expected to beat SolveBfs: at most
+// kBitboardMaxWidth columns, at least 1024 cells, and at least one loop per
+// eight cells. A perfect maze's frontier is about one cell per level, so it
+// gains nothing from whole-row steps.
+auto FavorsBitboardBfs(const MazeGrid& maze_grid) -> bool;
 auto SolveDfs(const MazeGrid& maze_grid, GridPosition start_node,
-              GridPosition end_node) -> SearchResult;
+              GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
 auto SolveAStar(const MazeGrid& maze_grid, GridPosition start_node,
-                GridPosition end_node) -> SearchResult;
+                GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+// HDA*: cells are owned by workers by hash, successors travel to their owner
+// through lock-free inboxes, and the search ends once no worker holds a cell
+// that could beat the best path to the end. Path length matches SolveAStar;
+// which of several shortest paths comes back can vary between runs.
+auto SolveParallelAStar(const MazeGrid& maze_grid, GridPosition start_node,
+                        GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
 auto SolveDijkstra(const MazeGrid& maze_grid, GridPosition start_node,
-                   GridPosition end_node) -> SearchResult;
+                   GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
 auto SolveGreedyBestFirst(const MazeGrid& maze_grid, GridPosition start_node,
-                          GridPosition end_node) -> SearchResult;
+                          GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+auto SolveJunctionGraph(const MazeGrid& maze_grid, GridPosition start_node,
+                        GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+auto SolveHierarchical(const MazeGrid& maze_grid, GridPosition start_node,
+                       GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+// Seals dead ends over the packed grid (FillDeadEnds) and reads the path
+// off the live cells; loops that survive the fill are crossed with a BFS.
+auto SolveDeadEndFilling(const MazeGrid& maze_grid, GridPosition start_node,
+                         GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+auto SolveTreeLca(const MazeGrid& maze_grid, GridPosition start_node,
+                  GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+auto SolveWallFollower(const MazeGrid& maze_grid, GridPosition start_node,
+                       GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
+auto SolveTremaux(const MazeGrid& maze_grid, GridPosition start_node,
+                  GridPosition end_node, const SolveOptions& options)
+    -> SearchResult;
 
 }  // namespace MazeSolverDomain::detail
 
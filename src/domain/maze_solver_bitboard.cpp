@@ -0,0 +1,371 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+
+namespace MazeSolverDomain::detail {
+
+namespace {
+
+// Bit c of a row is the cell in column c.
+using Row = std::uint64_t;
+
+// Open passages as row bitboards: right_ bit c joins (r, c) and (r, c + 1),
+// down_ bit c joins (r, c) and (r + 1, c).
+struct Bitboard {
+  int height;
+  int width;
+  std::vector<Row> right_;
+  std::vector<Row> down_;
+
+  explicit Bitboard(const MazeGrid& maze_grid)
+      : height(static_cast<int>(maze_grid.size())),
+        width(static_cast<int>(maze_grid[0].size())),
+        right_(maze_grid.size(), 0),
+        down_(maze_grid.size(), 0) {
+    // Passages off the grid edge are masked off afterwards.
+    const Row kInRow = (Row{1} << (width - 1)) - 1;
+    for (int row = 0; row < height; ++row) {
+      Row right = 0;
+      Row down = 0;
+      for (int col = 0; col < width; ++col) {
+        const auto& walls = maze_grid[row][col].walls;
+        right |= static_cast<Row>(!walls[kWallRight]) << col;
+        down |= static_cast<Row>(!walls[kWallBottom]) << col;
+      }
+      right_[row] = right & kInRow;
+      down_[row] = row + 1 < height ? down : 0;
+    }
+  }
+};
+
+auto HasBit(Row row, int col) -> bool { return ((row >> col) & 1U) != 0; }
+
+// A frontier row: the cells of `row` reached on one BFS level.
+struct RowBits {
+  int row;
+  Row bits;
+};
+
+class BitboardSearch {
+ public:
+  BitboardSearch(const Bitboard& board, SearchBudget& budget)
+      : board_(board),
+        budget_(budget),
+        visited_(static_cast<size_t>(board.height), 0),
+        next_(static_cast<size_t>(board.height), 0),
+        frontier_(static_cast<size_t>(board.height) + 2, 0) {
+    level_offsets_.reserve(static_cast<size_t>(board.height));
+    snapshots_.reserve(static_cast<size_t>(board.height));
+  }
+
+  // Level-synchronous BFS. A frontier row spreads its cells sideways
+  // (shifted left and right, masked by right_) and to the rows above and
+  // below (masked by down_), minus what was already visited. Every level is
+  // kept as its frontier rows in row order, which is both the next level's
+  // input and the snapshot the path is rebuilt from.
+  template <typename OnLevel>
+  auto Run(const PathEndpoints& endpoints, SearchStats& stats,
+           OnLevel on_level) -> bool {
+    const auto [kEndRow, kEndCol] = endpoints.end;
+    const Row kStart = Row{1} << endpoints.start.second;
+    visited_[endpoints.start.first] = kStart;
+    level_offsets_.push_back(0);
+    snapshots_.push_back({.row = endpoints.start.first, .bits = kStart});
+    size_t frontier_size = 1;
+    while (!HasBit(visited_[kEndRow], kEndCol)) {
+      if (!budget_.SpendMany(frontier_size)) {
+        return false;
+      }
+      const size_t kLevelBegin = level_offsets_.back();
+      const size_t kLevelEnd = snapshots_.size();
+      level_offsets_.push_back(kLevelEnd);
+      const int kFrom = std::max(snapshots_[kLevelBegin].row - 1, 0);
+      const int kTo =
+          std::min(snapshots_[kLevelEnd - 1].row + 1, board_.height - 1);
+      if (static_cast<size_t>(kTo - kFrom + 1) <=
+          kDenseRowsPerEntry * (kLevelEnd - kLevelBegin)) {
+        SweepWindow(kLevelBegin, kLevelEnd, kFrom, kTo);
+      } else {
+        SpreadEntries(kLevelBegin, kLevelEnd);
+      }
+      if (snapshots_.size() == kLevelEnd) {
+        level_offsets_.pop_back();
+        return false;
+      }
+      frontier_size = 0;
+      for (size_t entry = kLevelEnd; entry < snapshots_.size(); ++entry) {
+        frontier_size +=
+            static_cast<size_t>(std::popcount(snapshots_[entry].bits));
+      }
+      stats.pushed_ += frontier_size;
+      stats.peak_frontier_ = std::max(stats.peak_frontier_, frontier_size);
+      on_level(std::span(snapshots_).subspan(kLevelEnd));
+    }
+    return true;
+  }
+
+  auto Visited() const -> const std::vector<Row>& { return visited_; }
+
+  auto LevelCount() const -> size_t { return level_offsets_.size(); }
+
+  // Reached cell closest (Manhattan) to `target`, for a stopped search.
+  auto ClosestReached(GridPosition target) const -> GridPosition {
+    GridPosition best = kInvalidCell;
+    int best_distance = std::numeric_limits<int>::max();
+    for (int row = 0; row < board_.height; ++row) {
+      for (Row bits = visited_[row]; bits != 0; bits &= bits - 1) {
+        const GridPosition kCell = {row, std::countr_zero(bits)};
+        const int kDistance =
+            ManhattanDistance({.first = kCell, .second = target});
+        if (kDistance < best_distance) {
+          best = kCell;
+          best_distance = kDistance;
+        }
+      }
+    }
+    return best;
+  }
+
+  // Walks back from `cell`, first reached on `level`, one level at a time,
+  // each step to a neighbour through an open passage that the previous
+  // level's snapshot holds. Returned start -> cell.
+  auto PathTo(GridPosition cell, size_t level) const
+      -> std::vector<GridPosition> {
+    std::vector<GridPosition> path;
+    path.reserve(level + 1);
+    path.push_back(cell);
+    while (level-- > 0) {
+      const auto [kRow, kCol] = cell;
+      if (kRow > 0 && HasBit(board_.down_[kRow - 1], kCol) &&
+          InLevel(level, {kRow - 1, kCol})) {
+        cell = {kRow - 1, kCol};
+      } else if (kRow + 1 < board_.height &&
+                 HasBit(board_.down_[kRow], kCol) &&
+                 InLevel(level, {kRow + 1, kCol})) {
+        cell = {kRow + 1, kCol};
+      } else if (kCol > 0 && HasBit(board_.right_[kRow], kCol - 1) &&
+                 InLevel(level, {kRow, kCol - 1})) {
+        cell = {kRow, kCol - 1};
+      } else {
+        cell = {kRow, kCol + 1};
+      }
+      path.push_back(cell);
+    }
+    std::ranges::reverse(path);
+    return path;
+  }
+
+  auto LevelOf(GridPosition cell) const -> size_t {
+    size_t level = 0;
+    while (!InLevel(level, cell)) {
+      ++level;
+    }
+    return level;
+  }
+
+ private:
+  // A level whose rows span at most this many rows per frontier row is swept
+  // as a whole; a row costs a few shifts there, a frontier row spread on its
+  // own several times that.
+  static constexpr size_t kDenseRowsPerEntry = 8;
+
+  // Dense step: every row from one above the frontier's first row to one
+  // below its last is computed from the frontier rows around it.
+  void SweepWindow(size_t level_begin, size_t level_end, int from, int to) {
+    for (size_t entry = level_begin; entry < level_end; ++entry) {
+      frontier_[snapshots_[entry].row + 1] = snapshots_[entry].bits;
+    }
+    for (int row = from; row <= to; ++row) {
+      const Row kHere = frontier_[row + 1];
+      const Row kRight = board_.right_[row];
+      Row bits = ((kHere & kRight) << 1) | ((kHere >> 1) & kRight) |
+                 (frontier_[row + 2] & board_.down_[row]);
+      if (row > 0) {
+        bits |= frontier_[row] & board_.down_[row - 1];
+      }
+      bits &= ~visited_[row];
+      if (bits != 0) {
+        visited_[row] |= bits;
+        snapshots_.push_back({.row = row, .bits = bits});
+      }
+    }
+    for (size_t entry = level_begin; entry < level_end; ++entry) {
+      frontier_[snapshots_[entry].row + 1] = 0;
+    }
+  }
+
+  // Sparse step, for a frontier thinly spread over many rows: each frontier
+  // row spreads into next_ on its own, and only the rows it reaches are
+  // touched.
+  void SpreadEntries(size_t level_begin, size_t level_end) {
+    touched_rows_.clear();
+    for (size_t entry = level_begin; entry < level_end; ++entry) {
+      const auto [kRow, kBits] = snapshots_[entry];
+      const Row kRight = board_.right_[kRow];
+      Spread(kRow, ((kBits & kRight) << 1) | ((kBits >> 1) & kRight));
+      if (kRow > 0) {
+        Spread(kRow - 1, kBits & board_.down_[kRow - 1]);
+      }
+      if (kRow + 1 < board_.height) {
+        Spread(kRow + 1, kBits & board_.down_[kRow]);
+      }
+    }
+    // Rows are touched nearly in order; most levels need no sort.
+    if (!std::ranges::is_sorted(touched_rows_)) {
+      std::ranges::sort(touched_rows_);
+    }
+    for (const int kRow : touched_rows_) {
+      const Row kBits = std::exchange(next_[kRow], 0);
+      visited_[kRow] |= kBits;
+      snapshots_.push_back({.row = kRow, .bits = kBits});
+    }
+  }
+
+  void Spread(int row, Row bits) {
+    bits &= ~visited_[row];
+    if (bits == 0) {
+      return;
+    }
+    if (next_[row] == 0) {
+      touched_rows_.push_back(row);
+    }
+    next_[row] |= bits;
+  }
+
+  auto Level(size_t level) const -> std::span<const RowBits> {
+    const size_t kEnd = level + 1 < level_offsets_.size()
+                            ? level_offsets_[level + 1]
+                            : snapshots_.size();
+    return std::span(snapshots_)
+        .subspan(level_offsets_[level], kEnd - level_offsets_[level]);
+  }
+  auto InLevel(size_t level, GridPosition cell) const -> bool {
+    const std::span<const RowBits> kRows = Level(level);
+    const auto kEntry = std::ranges::lower_bound(kRows, cell.first, {},
+                                                 &RowBits::row);
+    return kEntry != kRows.end() && kEntry->row == cell.first &&
+           HasBit(kEntry->bits, cell.second);
+  }
+  const Bitboard& board_;
+  SearchBudget& budget_;
+  std::vector<Row> visited_;
+  // Cells reached on the level being built, and the rows holding them.
+  std::vector<Row> next_;
+  std::vector<int> touched_rows_;
+  // The frontier as dense rows for SweepWindow, shifted down one row so the
+  // rows above the first and below the last read as empty.
+  std::vector<Row> frontier_;
+  // Every level's frontier rows, level after level.
+  std::vector<size_t> level_offsets_;
+  std::vector<RowBits> snapshots_;
+};
+
+}  // namespace
+
+auto FavorsBitboardBfs(const MazeGrid& maze_grid) -> bool {
+  constexpr size_t kMinCells = 1024;
+  constexpr size_t kCellsPerLoop = 8;
+  if (maze_grid.empty() || maze_grid[0].size() > kBitboardMaxWidth) {
+    return false;
+  }
+  const size_t kCells = maze_grid.size() * maze_grid[0].size();
+  if (kCells < kMinCells) {
+    return false;
+  }
+  // A connected maze with cells - 1 passages is a tree; every passage beyond
+  // that closes a loop.
+  size_t passages = 0;
+  for (const auto& row : maze_grid) {
+    for (const auto& cell : row) {
+      passages += static_cast<size_t>(!cell.walls[kWallRight]) +
+                  static_cast<size_t>(!cell.walls[kWallBottom]);
+    }
+  }
+  return passages + 1 >= kCells + (kCells / kCellsPerLoop);
+}
+
+auto SolveBitboardBfs(const MazeGrid& maze_grid, GridPosition start_node,
+                      GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (kGridSize->width > kBitboardMaxWidth) {
+    return SolveBfs(maze_grid, start_node, end_node, options);
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  const PathEndpoints kEndpoints{.start = start_node, .end = end_node};
+  const Bitboard kBoard(maze_grid);
+  SearchResult result;
+  SearchBudget budget(options);
+  BitboardSearch search(kBoard, budget);
+
+  bool found = false;
+  StateGrid visual_states;
+  if (options.record_frames) {
+    // One frame per level: the previous frontier turns visited.
+    visual_states = CreateStateGrid(*kGridSize, SolverCellState::NONE);
+    visual_states[start_node.first][start_node.second] =
+        SolverCellState::FRONTIER;
+    PushFrame(result, visual_states, {});
+    std::vector<GridPosition> previous = {start_node};
+    found = search.Run(
+        kEndpoints, result.stats_,
+        [&](std::span<const RowBits> reached) {
+          for (const GridPosition& cell : previous) {
+            visual_states[cell.first][cell.second] =
+                SolverCellState::VISITED_PROC;
+          }
+          previous.clear();
+          for (const RowBits& entry : reached) {
+            for (Row bits = entry.bits; bits != 0; bits &= bits - 1) {
+              previous.emplace_back(entry.row, std::countr_zero(bits));
+              visual_states[entry.row][previous.back().second] =
+                  SolverCellState::FRONTIER;
+            }
+          }
+          RecordFrame(budget, result, visual_states);
+        });
+  } else {
+    found = search.Run(kEndpoints, result.stats_,
+                       [](std::span<const RowBits>) {});
+  }
+
+  if (found) {
+    // The end is on the last level.
+    result.path_ = search.PathTo(end_node, search.LevelCount() - 1);
+  } else if (budget.Stopped()) {
+    const GridPosition kClosest = search.ClosestReached(end_node);
+    result.path_ = search.PathTo(kClosest, search.LevelOf(kClosest));
+  }
+  if (options.record_frames) {
+    for (const GridPosition& node : result.path_) {
+      visual_states[node.first][node.second] = SolverCellState::SOLUTION;
+    }
+    PushFrame(result, visual_states, result.path_);
+  }
+  result.explored_ = CreateBoolGrid(*kGridSize, false);
+  for (int row = 0; row < kGridSize->height; ++row) {
+    for (Row bits = search.Visited()[row]; bits != 0; bits &= bits - 1) {
+      result.explored_[row][std::countr_zero(bits)] = true;
+    }
+  }
+  result.found_ = found;
+  SetTermination(budget, result);
+  return result;
+}
+
+}  // namespace MazeSolverDomain::detail
@@ -7,60 +7,57 @@ namespace MazeSolverDomain::detail {
 
 namespace {
 
-struct StraightLineTriplet {
-  GridPosition first;
-  GridPosition second;
-  GridPosition third;
-};
-
-auto IsStraightLine(StraightLineTriplet line) -> bool {
-  if (line.first == kInvalidCell || line.second == kInvalidCell ||
-      line.third == kInvalidCell) {
-    return false;
-  }
-  const int kDeltaR1 = line.second.first - line.first.first;
-  const int kDeltaC1 = line.second.second - line.first.second;
-  const int kDeltaR2 = line.third.first - line.second.first;
-  const int kDeltaC2 = line.third.second - line.second.second;
-  return kDeltaR1 == kDeltaR2 && kDeltaC1 == kDeltaC2;
-}
-
-auto ShouldSkipStraightLineFrame(const ParentGrid& parents,
-                                 GridPosition current) -> bool {
-  const GridPosition kParentCell = parents[current.first][current.second];
-  if (kParentCell == kInvalidCell) {
-    return false;
-  }
-  const GridPosition kGrandparentCell =
-      parents[kParentCell.first][kParentCell.second];
-  if (kGrandparentCell == kInvalidCell) {
-    return false;
-  }
-  const StraightLineTriplet kLine{
-      .first = kGrandparentCell, .second = kParentCell, .third = current};
-  return IsStraightLine(kLine);
-}
-
 void AppendSolutionPath(const PathEndpoints& endpoints,
                         const ParentGrid& parents,
                         StateGrid& visual_states, SearchResult& result) {
+  result.path_ = ExtractParentPath(parents, endpoints);
+  for (const GridPosition& node : result.path_) {
+    visual_states[node.first][node.second] = SolverCellState::SOLUTION;
+  }
+  PushFrame(result, visual_states, result.path_);
+}
+
+}  // namespace
+
+auto ExtractParentPath(const ParentGrid& parents,
+                       const PathEndpoints& endpoints)
+    -> std::vector<GridPosition> {
   std::vector<GridPosition> path;
   GridPosition path_node = endpoints.end;
   while (path_node != kInvalidCell) {
     path.push_back(path_node);
-    visual_states[path_node.first][path_node.second] =
-        SolverCellState::SOLUTION;
     if (path_node == endpoints.start) {
       break;
     }
     path_node = parents[path_node.first][path_node.second];
   }
   std::ranges::reverse(path);
-  result.path_ = path;
-  PushFrame(result, visual_states, path);
+  return path;
 }
 
-}  // namespace
+auto ClosestExploredCell(const PathEndpoints& endpoints,
+                         const ParentGrid& parents, const BoolGrid& visited)
+    -> GridPosition {
+  GridPosition closest = endpoints.start;
+  int closest_distance =
+      ManhattanDistance({.first = endpoints.start, .second = endpoints.end});
+  for (size_t row = 0; row < visited.size(); ++row) {
+    for (size_t col = 0; col < visited[row].size(); ++col) {
+      if (!visited[row][col] || parents[row][col] == kInvalidCell) {
+        continue;
+      }
+      const GridPosition kCell = {static_cast<int>(row),
+                                  static_cast<int>(col)};
+      const int kDistance =
+          ManhattanDistance({.first = kCell, .second = endpoints.end});
+      if (kDistance < closest_distance) {
+        closest_distance = kDistance;
+        closest = kCell;
+      }
+    }
+  }
+  return closest;
+}
 
 auto GetGridSize(const MazeGrid& maze_grid) -> std::optional<GridSize> {
   const int kHeight = static_cast<int>(maze_grid.size());
@@ -112,20 +109,11 @@ void PushFrame(SearchResult& result,
   result.frames_.push_back(std::move(frame));
 }
 
-auto ShouldSaveFrameForCurrent(const ParentGrid& parents, GridPosition current,
-                               const PathEndpoints& endpoints) -> bool {
-  if (current == endpoints.end) {
-    return true;
-  }
-  return !ShouldSkipStraightLineFrame(parents, current);
-}
-
-auto ShouldSaveBacktrackFrame(const ParentGrid& parents, GridPosition current,
-                              const PathEndpoints& endpoints) -> bool {
-  if (current == endpoints.start || current == endpoints.end) {
-    return true;
+void RecordFrame(const SearchBudget& budget, SearchResult& result,
+                 const StateGrid& visual_states) {
+  if (budget.CanRecordFrame(result.frames_.size())) {
+    PushFrame(result, visual_states, {});
   }
-  return !ShouldSkipStraightLineFrame(parents, current);
 }
 
 auto CreateTrivialResult(GridSize grid_size, GridPosition node) -> SearchResult {
@@ -141,18 +129,60 @@ auto CreateTrivialResult(GridSize grid_size, GridPosition node) -> SearchResult
   return result;
 }
 
+auto CreatePathResult(GridSize grid_size, const PathEndpoints& endpoints,
+                      bool found, std::vector<GridPosition> path)
+    -> SearchResult {
+  SearchResult result;
+  auto visual_states = CreateStateGrid(grid_size, SolverCellState::NONE);
+  auto visited = CreateBoolGrid(grid_size, false);
+  visual_states[endpoints.start.first][endpoints.start.second] =
+      SolverCellState::FRONTIER;
+  PushFrame(result, visual_states, {});
+
+  if (found) {
+    for (const GridPosition& node : path) {
+      visited[node.first][node.second] = true;
+      visual_states[node.first][node.second] = SolverCellState::SOLUTION;
+    }
+    result.path_ = std::move(path);
+  }
+  PushFrame(result, visual_states, result.path_);
+  result.explored_ = std::move(visited);
+  result.found_ = found;
+  return result;
+}
+
+auto CreateStoppedResult(GridSize grid_size, const PathEndpoints& endpoints,
+                         const SearchBudget& budget) -> SearchResult {
+  SearchResult result = CreatePathResult(grid_size, endpoints, false, {});
+  result.path_.push_back(endpoints.start);
+  SetTermination(budget, result);
+  return result;
+}
+
 void FinalizeSearchResult(bool found, const PathEndpoints& endpoints,
                           const ParentGrid& parents,
                           StateGrid& visual_states, BoolGrid&& visited,
-                          SearchResult& result) {
+                          const SearchBudget& budget, SearchResult& result) {
   if (found) {
     AppendSolutionPath(endpoints, parents, visual_states, result);
+  } else if (budget.Stopped()) {
+    const PathEndpoints kPartial{
+        .start = endpoints.start,
+        .end = ClosestExploredCell(endpoints, parents, visited)};
+    AppendSolutionPath(kPartial, parents, visual_states, result);
   } else {
     PushFrame(result, visual_states, {});
   }
 
   result.found_ = found;
   result.explored_ = std::move(visited);
+  SetTermination(budget, result);
+}
+
+void SetTermination(const SearchBudget& budget, SearchResult& result) {
+  result.termination_ = budget.Termination();
+  result.stats_.expanded_ = budget.Expanded();
 }
 
 auto ManhattanDistance(PositionPair positions) -> int {
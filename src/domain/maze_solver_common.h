@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "domain/maze_search_budget.h"
 #include "domain/maze_solver.h"
 
 namespace MazeSolverDomain::detail {
@@ -15,6 +16,8 @@ using GridPosition = MazeSolverDomain::GridPosition;
 using SearchFrame = MazeSolverDomain::SearchFrame;
 using SearchResult = MazeSolverDomain::SearchResult;
 using SolverCellState = MazeSolverDomain::SolverCellState;
+using SolveOptions = MazeSolverDomain::SolveOptions;
+using SearchBudget = MazeSolverDomain::SearchBudget;
 using BoolGrid = std::vector<std::vector<bool>>;
 using IntGrid = std::vector<std::vector<int>>;
 using StateGrid = std::vector<std::vector<SolverCellState>>;
@@ -44,32 +47,6 @@ struct PositionPair {
   GridPosition second;
 };
 
-struct DirectionDeltas {
-  std::array<int, kWallCount> row_delta;
-  std::array<int, kWallCount> col_delta;
-  std::array<int, kWallCount> wall_check_index;
-};
-
-struct SearchTargets {
-  GridPosition current;
-  GridPosition end;
-};
-
-struct AStarNode {
-  int f_score;
-  int g_score;
-  GridPosition pos;
-};
-
-struct AStarNodeCompare {
-  auto operator()(const AStarNode& left, const AStarNode& right) const -> bool {
-    if (left.f_score != right.f_score) {
-      return left.f_score > right.f_score;
-    }
-    return left.g_score > right.g_score;
-  }
-};
-
 auto GetGridSize(const MazeGrid& maze_grid) -> std::optional<GridSize>;
 auto IsValidPosition(GridPosition pos, GridSize grid_size) -> bool;
 auto CreateBoolGrid(GridSize grid_size, bool initial) -> BoolGrid;
@@ -78,14 +55,33 @@ auto CreateStateGrid(GridSize grid_size, SolverCellState initial) -> StateGrid;
 auto CreateParentGrid(GridSize grid_size, GridPosition initial) -> ParentGrid;
 void PushFrame(SearchResult& result, const StateGrid& visual_states,
                const std::vector<GridPosition>& current_path);
-auto ShouldSaveFrameForCurrent(const ParentGrid& parents, GridPosition current,
-                               const PathEndpoints& endpoints) -> bool;
-auto ShouldSaveBacktrackFrame(const ParentGrid& parents, GridPosition current,
-                              const PathEndpoints& endpoints) -> bool;
+// In-loop frame with no path; dropped once the budget's frame cap is reached.
+void RecordFrame(const SearchBudget& budget, SearchResult& result,
+                 const StateGrid& visual_states);
 auto CreateTrivialResult(GridSize grid_size, GridPosition node) -> SearchResult;
+auto CreatePathResult(GridSize grid_size, const PathEndpoints& endpoints,
+                      bool found, std::vector<GridPosition> path)
+    -> SearchResult;
+// Follows parents back from endpoints.end; returned start -> end.
+auto ExtractParentPath(const ParentGrid& parents,
+                       const PathEndpoints& endpoints)
+    -> std::vector<GridPosition>;
+// Explored cell with a parent chain to the start that is closest (Manhattan)
+// to the end; the start itself when nothing better was reached.
+auto ClosestExploredCell(const PathEndpoints& endpoints,
+                         const ParentGrid& parents, const BoolGrid& visited)
+    -> GridPosition;
+// A search stopped by its budget reports the parent-chain path to the
+// explored cell closest to the end instead of the solution.
+// Result for a search whose budget ran out before it could start; the partial
+// path is just the start cell.
+auto CreateStoppedResult(GridSize grid_size, const PathEndpoints& endpoints,
+                         const SearchBudget& budget) -> SearchResult;
 void FinalizeSearchResult(bool found, const PathEndpoints& endpoints,
                           const ParentGrid& parents, StateGrid& visual_states,
-                          BoolGrid&& visited, SearchResult& result);
+                          BoolGrid&& visited, const SearchBudget& budget,
+                          SearchResult& result);
+void SetTermination(const SearchBudget& budget, SearchResult& result);
 auto ManhattanDistance(PositionPair positions) -> int;
 
 }  // namespace MazeSolverDomain::detail
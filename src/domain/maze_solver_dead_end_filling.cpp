@@ -0,0 +1,147 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include <bit>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_dead_end_filler.h"
+#include "domain/maze_search_kernel.h"
+
+namespace MazeSolverDomain::detail {
+
+namespace {
+
+enum class Walk { kReachedEnd, kStuck, kJunction, kStopped };
+
+// Follows the live cells from the start. In a perfect maze they form a single
+// corridor to the end; a live junction means loops survived the fill.
+auto WalkLiveCorridor(const MazeAdjacency& adjacency, const DeadEndFill& fill,
+                      const PathEndpoints& endpoints, SearchBudget& budget,
+                      std::vector<GridPosition>& path) -> Walk {
+  const int kEnd = adjacency.IndexOf(endpoints.end);
+  int previous = kNoCell;
+  int cell = adjacency.IndexOf(endpoints.start);
+  path.push_back(endpoints.start);
+  while (cell != kEnd) {
+    if (!budget.Spend()) {
+      return Walk::kStopped;
+    }
+    int next = kNoCell;
+    unsigned mask = adjacency.OpenMask(cell);
+    while (mask != 0) {
+      const int kNeighbor = adjacency.Neighbor(cell, std::countr_zero(mask));
+      mask &= mask - 1;
+      if (kNeighbor == previous ||
+          !fill.IsLive(adjacency.PositionOf(kNeighbor))) {
+        continue;
+      }
+      if (next != kNoCell) {
+        return Walk::kJunction;
+      }
+      next = kNeighbor;
+    }
+    if (next == kNoCell) {
+      return Walk::kStuck;
+    }
+    previous = cell;
+    cell = next;
+    path.push_back(adjacency.PositionOf(cell));
+  }
+  return Walk::kReachedEnd;
+}
+
+}  // namespace
+
+auto SolveDeadEndFilling(const MazeGrid& maze_grid, GridPosition start_node,
+                         GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  const PathEndpoints kEndpoints{.start = start_node, .end = end_node};
+  SearchBudget budget(options);
+  if (!budget.Poll()) {
+    return CreateStoppedResult(*kGridSize, kEndpoints, budget);
+  }
+  const MazeAdjacency kAdjacency(maze_grid);
+  const DeadEndFill kFill = FillDeadEnds(kAdjacency, start_node, end_node);
+
+  // The fill has no per-cell hook; the deadline and stop token are checked
+  // around it.
+  if (!budget.Poll()) {
+    SearchResult result = CreateStoppedResult(*kGridSize, kEndpoints, budget);
+    result.stats_.filled_ = kFill.filled_;
+    return result;
+  }
+
+  SearchResult result;
+  const Walk kWalk =
+      WalkLiveCorridor(kAdjacency, kFill, kEndpoints, budget, result.path_);
+  const size_t kWalked = budget.Expanded();
+  if (kWalk == Walk::kJunction && options.max_expanded_nodes != 0 &&
+      kWalked >= options.max_expanded_nodes) {
+    // The walk used up the node limit, and a BFS limit of 0 would mean none;
+    // Spend() fails here and records the limit.
+    budget.Spend();
+    result = CreateStoppedResult(*kGridSize, kEndpoints, budget);
+  } else if (kWalk == Walk::kJunction) {
+    // Loops are left; a BFS over the sealed grid picks the shortest way
+    // through them within what the walk left of the node limit.
+    MazeGrid filled_grid = maze_grid;
+    SealFilledCells(filled_grid, kFill);
+    // The path is marked on the frames below; Solve() compacts it after.
+    SolveOptions search_options = options;
+    if (options.max_expanded_nodes != 0) {
+      search_options.max_expanded_nodes -= kWalked;
+    }
+    search_options.record_frames = false;
+    search_options.compact_path = false;
+    result = SolveBfs(filled_grid, start_node, end_node, search_options);
+    result.stats_.expanded_ += kWalked;
+  } else {
+    result.found_ = kWalk == Walk::kReachedEnd;
+    if (kWalk == Walk::kStuck) {
+      result.path_.clear();
+    }
+    result.explored_ = CreateBoolGrid(*kGridSize, false);
+    for (const GridPosition& node : result.path_) {
+      result.explored_[node.first][node.second] = true;
+    }
+    SetTermination(budget, result);
+  }
+
+  for (int row = 0; row < kGridSize->height; ++row) {
+    for (int col = 0; col < kGridSize->width; ++col) {
+      if (!kFill.IsLive({row, col})) {
+        result.explored_[row][col] = true;
+      }
+    }
+  }
+  if (options.record_frames) {
+    auto visual_states = CreateStateGrid(*kGridSize, SolverCellState::NONE);
+    for (int row = 0; row < kGridSize->height; ++row) {
+      for (int col = 0; col < kGridSize->width; ++col) {
+        if (!kFill.IsLive({row, col})) {
+          visual_states[row][col] = SolverCellState::VISITED_PROC;
+        }
+      }
+    }
+    PushFrame(result, visual_states, {});
+    for (const GridPosition& node : result.path_) {
+      visual_states[node.first][node.second] = SolverCellState::SOLUTION;
+    }
+    PushFrame(result, visual_states, result.path_);
+  }
+  result.stats_.filled_ = kFill.filled_;
+  return result;
+}
+
+}  // namespace MazeSolverDomain::detail
@@ -0,0 +1,66 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include <chrono>
+#include <optional>
+
+#include "domain/maze_cluster_graph.h"
+
+namespace MazeSolverDomain::detail {
+
+auto SolveHierarchical(const MazeGrid& maze_grid, GridPosition start_node,
+                       GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  // The cluster build has no per-cell hook; the deadline and stop token are
+  // checked around it. The query charges every abstract expansion and every
+  // cell its cluster searches reach.
+  const PathEndpoints kEndpoints{.start = start_node, .end = end_node};
+  SearchBudget budget(options);
+  if (!budget.Poll()) {
+    return CreateStoppedResult(*kGridSize, kEndpoints, budget);
+  }
+  const int kClusterSize = options.cluster_size > 0
+                               ? options.cluster_size
+                               : ClusterGraph::kDefaultClusterSize;
+  const ClusterGraph* graph = options.cluster_graph;
+  std::optional<ClusterGraph> built;
+  double build_seconds = 0.0;
+  if (graph == nullptr || graph->Height() != kGridSize->height ||
+      graph->Width() != kGridSize->width ||
+      graph->ClusterSize() != kClusterSize) {
+    const auto kBuildStart = std::chrono::steady_clock::now();
+    graph = &built.emplace(maze_grid, kClusterSize, 0);
+    build_seconds = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - kBuildStart)
+                        .count();
+    if (!budget.Poll()) {
+      SearchResult result = CreateStoppedResult(*kGridSize, kEndpoints, budget);
+      result.stats_.preprocess_seconds_ = build_seconds;
+      return result;
+    }
+  }
+  ClusterGraph::Workspace workspace;
+  HierarchicalPath path =
+      graph->FindPath(start_node, end_node, workspace, &budget);
+  SearchResult result =
+      budget.Stopped()
+          ? CreateStoppedResult(*kGridSize, kEndpoints, budget)
+          : CreatePathResult(*kGridSize, kEndpoints, path.found_,
+                             std::move(path.path_));
+  result.stats_.expanded_ = budget.Expanded();
+  result.stats_.preprocess_seconds_ = build_seconds;
+  return result;
+}
+
+}  // namespace MazeSolverDomain::detail
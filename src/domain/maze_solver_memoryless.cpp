@@ -0,0 +1,93 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include "domain/maze_grid_access.h"
+#include "domain/maze_memoryless_solver.h"
+
+namespace MazeSolverDomain::detail {
+
+namespace {
+
+// A walk stopped by its budget still hands over the route it has so far.
+auto CreateWalkResult(GridSize grid_size, const PathEndpoints& endpoints,
+                      const WalkResult& walk, const SearchBudget& budget,
+                      std::vector<GridPosition> path) -> SearchResult {
+  const bool kHasRoute = walk.found_ || walk.stopped_;
+  SearchResult result =
+      CreatePathResult(grid_size, endpoints, kHasRoute,
+                       kHasRoute ? std::move(path)
+                                 : std::vector<GridPosition>{});
+  result.found_ = walk.found_;
+  SetTermination(budget, result);
+  return result;
+}
+
+}  // namespace
+
+auto SolveWallFollower(const MazeGrid& maze_grid, GridPosition start_node,
+                       GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  // Erase the walk's loops (dead-end retreats) as it goes, so the result is
+  // a simple route: revisiting a cell cuts the path back to it.
+  SearchBudget budget(options);
+  auto path_index = CreateIntGrid(*kGridSize, -1);
+  std::vector<GridPosition> path;
+  const WalkResult kWalk = FollowWall(
+      InMemoryGridAccess(maze_grid), start_node, end_node,
+      [&](GridPosition pos) -> void {
+        const int kIndex = path_index[pos.first][pos.second];
+        if (kIndex >= 0) {
+          for (size_t i = static_cast<size_t>(kIndex) + 1; i < path.size();
+               ++i) {
+            path_index[path[i].first][path[i].second] = -1;
+          }
+          path.resize(static_cast<size_t>(kIndex) + 1);
+          return;
+        }
+        path_index[pos.first][pos.second] = static_cast<int>(path.size());
+        path.push_back(pos);
+      },
+      [&budget]() -> bool { return budget.Spend(); });
+
+  return CreateWalkResult(*kGridSize, {.start = start_node, .end = end_node},
+                          kWalk, budget, std::move(path));
+}
+
+auto SolveTremaux(const MazeGrid& maze_grid, GridPosition start_node,
+                  GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  SearchBudget budget(options);
+  std::vector<GridPosition> path;
+  const WalkResult kWalk = WalkTremaux(
+      InMemoryGridAccess(maze_grid), start_node, end_node,
+      [&path](GridPosition pos) -> void { path.push_back(pos); },
+      [&budget]() -> bool { return budget.Spend(); });
+
+  return CreateWalkResult(*kGridSize, {.start = start_node, .end = end_node},
+                          kWalk, budget, std::move(path));
+}
+
+}  // namespace MazeSolverDomain::detail
@@ -0,0 +1,436 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_search_kernel.h"
+
+namespace MazeSolverDomain::detail {
+
+namespace {
+
+constexpr int kFarAway = std::numeric_limits<int>::max() / 4;
+// Cells are dealt to workers in square blocks: most successors stay with the
+// worker that generated them, and hashing the block keeps the frontier of any
+// one region spread over every worker.
+constexpr int kOwnerBlockShift = 3;
+// Worker ids are stored one byte per cell.
+constexpr unsigned kMaxWorkers = 64;
+// Expansions between inbox checks and outbox flushes.
+constexpr int kExpansionsPerRound = 64;
+constexpr size_t kMessagesPerBatch = 256;
+// Expansions a worker counts locally before adding them to the shared total
+// checked against options.max_expanded_nodes; small limits report sooner.
+constexpr size_t kMaxExpansionsPerReport = 256;
+constexpr size_t kCacheLine = 64;
+
+// A successor handed to the worker that owns its cell.
+struct Message {
+  int cell;
+  int g_score;
+  int parent;
+};
+
+struct MessageBatch {
+  MessageBatch* next = nullptr;
+  std::vector<Message> messages;
+};
+
+// Lock-free multi-producer, single-consumer inbox: producers push whole
+// batches onto an intrusive stack and the owner takes the stack in one
+// exchange, so no node is ever popped while another thread reads it.
+class Inbox {
+ public:
+  void Push(std::unique_ptr<MessageBatch> batch) {
+    MessageBatch* node = batch.release();
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+  auto TakeAll() -> MessageBatch* {
+    return head_.exchange(nullptr, std::memory_order_acquire);
+  }
+
+ private:
+  std::atomic<MessageBatch*> head_{nullptr};
+};
+
+struct QueueEntry {
+  int f_score;
+  int g_score;
+  int cell;
+};
+
+// Min-heap on f, deeper entries first among equal f.
+struct WorseEntry {
+  auto operator()(const QueueEntry& lhs, const QueueEntry& rhs) const
+      -> bool {
+    return lhs.f_score != rhs.f_score ? lhs.f_score > rhs.f_score
+                                      : lhs.g_score < rhs.g_score;
+  }
+};
+
+struct alignas(kCacheLine) Worker {
+  Inbox inbox;
+  std::vector<QueueEntry> heap;
+  std::vector<std::unique_ptr<MessageBatch>> outbox;
+  SearchStats stats;
+};
+
+// State shared by every worker. g_scores_, parents_ and expanded_ of a cell
+// are only touched by the cell's owner until the workers are joined.
+class ParallelSearch {
+ public:
+  ParallelSearch(const MazeAdjacency& adjacency, CellEndpoints endpoints,
+                 unsigned worker_count, const SolveOptions& options)
+      : adjacency_(adjacency),
+        neighbors_(adjacency, kQueueNeighborOrder),
+        endpoints_(endpoints),
+        end_(adjacency.PositionOf(endpoints.end)),
+        options_(options),
+        owners_(static_cast<size_t>(adjacency.CellCount())),
+        g_scores_(owners_.size(), kFarAway),
+        parents_(owners_.size(), kNoCell),
+        expanded_(owners_.size(), 0),
+        workers_(worker_count),
+        report_interval_(
+            options.max_expanded_nodes == 0
+                ? kMaxExpansionsPerReport
+                : std::clamp<size_t>(options.max_expanded_nodes / worker_count,
+                                     1, kMaxExpansionsPerReport)),
+        unfinished_work_(static_cast<std::int64_t>(worker_count)) {
+    const int kBlockCols = (adjacency.Width() >> kOwnerBlockShift) + 1;
+    for (int cell = 0; cell < adjacency.CellCount(); ++cell) {
+      const GridPosition kPos = adjacency.PositionOf(cell);
+      const auto kBlock = static_cast<std::uint64_t>(
+          ((kPos.first >> kOwnerBlockShift) * kBlockCols) +
+          (kPos.second >> kOwnerBlockShift));
+      owners_[cell] = static_cast<std::uint8_t>(
+          ((kBlock * 0x9E3779B97F4A7C15ULL) >> 32) % worker_count);
+    }
+    for (Worker& worker : workers_) {
+      worker.outbox.resize(worker_count);
+    }
+  }
+
+  ParallelSearch(const ParallelSearch&) = delete;
+  auto operator=(const ParallelSearch&) -> ParallelSearch& = delete;
+
+  ~ParallelSearch() {
+    for (Worker& worker : workers_) {
+      for (MessageBatch* batch = worker.inbox.TakeAll(); batch != nullptr;) {
+        std::unique_ptr<MessageBatch> owned(batch);
+        batch = batch->next;
+      }
+    }
+  }
+
+  void Run() {
+    Relax(workers_[owners_[endpoints_.start]], endpoints_.start, 0, kNoCell);
+    std::vector<std::jthread> pool;
+    pool.reserve(workers_.size() - 1);
+    for (unsigned worker = 1; worker < workers_.size(); ++worker) {
+      pool.emplace_back([this, worker]() -> void { Work(worker); });
+    }
+    Work(0);
+  }
+
+  auto Found() const -> bool {
+    return incumbent_.load(std::memory_order_relaxed) < kFarAway &&
+           Termination() == SearchTermination::COMPLETED;
+  }
+  auto Termination() const -> SearchTermination {
+    return termination_.load(std::memory_order_relaxed);
+  }
+  auto Parents() -> std::vector<int>& { return parents_; }
+  auto Reached() const -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> reached(g_scores_.size(), 0);
+    for (size_t cell = 0; cell < reached.size(); ++cell) {
+      reached[cell] = g_scores_[cell] < kFarAway ? 1 : 0;
+    }
+    return reached;
+  }
+  auto Expanded() const -> const std::vector<std::uint8_t>& {
+    return expanded_;
+  }
+  auto Stats() const -> SearchStats {
+    SearchStats total;
+    for (const Worker& worker : workers_) {
+      total.expanded_ += worker.stats.expanded_;
+      total.pushed_ += worker.stats.pushed_;
+      total.stale_pops_ += worker.stats.stale_pops_;
+      total.peak_frontier_ =
+          std::max(total.peak_frontier_, worker.stats.peak_frontier_);
+    }
+    return total;
+  }
+
+ private:
+  auto Heuristic(int cell) const -> int {
+    return ManhattanDistance(
+        {.first = adjacency_.PositionOf(cell), .second = end_});
+  }
+  auto Incumbent() const -> int {
+    return incumbent_.load(std::memory_order_relaxed);
+  }
+  auto HasWork(const Worker& worker) const -> bool {
+    return !worker.heap.empty() && worker.heap.front().f_score < Incumbent();
+  }
+
+  // Runs on the cell's owner only.
+  void Relax(Worker& worker, int cell, int g_score, int parent) {
+    const int kFScore = g_score + Heuristic(cell);
+    if (g_score >= g_scores_[cell] || kFScore >= Incumbent()) {
+      return;
+    }
+    g_scores_[cell] = g_score;
+    parents_[cell] = parent;
+    if (cell == endpoints_.end) {
+      // The end's owner is the only writer; later workers prune against it.
+      incumbent_.store(g_score, std::memory_order_relaxed);
+      return;
+    }
+    worker.heap.push_back(
+        {.f_score = kFScore, .g_score = g_score, .cell = cell});
+    std::ranges::push_heap(worker.heap, WorseEntry{});
+    ++worker.stats.pushed_;
+    worker.stats.peak_frontier_ =
+        std::max(worker.stats.peak_frontier_, worker.heap.size());
+  }
+
+  void Send(unsigned from, unsigned to, const Message& message) {
+    auto& batch = workers_[from].outbox[to];
+    if (!batch) {
+      batch = std::make_unique<MessageBatch>();
+      batch->messages.reserve(kMessagesPerBatch);
+    }
+    batch->messages.push_back(message);
+    if (batch->messages.size() == kMessagesPerBatch) {
+      Flush(to, batch);
+    }
+  }
+
+  // Counted before it is visible, so unfinished_work_ cannot reach zero
+  // while a message is in flight.
+  void Flush(unsigned to, std::unique_ptr<MessageBatch>& batch) {
+    unfinished_work_.fetch_add(
+        static_cast<std::int64_t>(batch->messages.size()),
+        std::memory_order_relaxed);
+    workers_[to].inbox.Push(std::move(batch));
+  }
+
+  void Receive(unsigned id, bool& idle) {
+    Worker& worker = workers_[id];
+    MessageBatch* batch = worker.inbox.TakeAll();
+    if (batch == nullptr) {
+      return;
+    }
+    if (idle) {
+      // Rejoin before the messages are retired.
+      unfinished_work_.fetch_add(1, std::memory_order_relaxed);
+      idle = false;
+    }
+    std::int64_t received = 0;
+    while (batch != nullptr) {
+      std::unique_ptr<MessageBatch> owned(batch);
+      for (const Message& message : owned->messages) {
+        Relax(worker, message.cell, message.g_score, message.parent);
+      }
+      received += static_cast<std::int64_t>(owned->messages.size());
+      batch = owned->next;
+    }
+    unfinished_work_.fetch_sub(received, std::memory_order_release);
+  }
+
+  // False once the search has to stop.
+  auto Expand(unsigned id, SearchBudget& budget, size_t& unreported) -> bool {
+    Worker& worker = workers_[id];
+    std::ranges::pop_heap(worker.heap, WorseEntry{});
+    const QueueEntry kEntry = worker.heap.back();
+    worker.heap.pop_back();
+    if (kEntry.g_score != g_scores_[kEntry.cell]) {
+      ++worker.stats.stale_pops_;
+      return true;
+    }
+    if (!budget.Spend()) {
+      Stop(budget.Termination());
+      return false;
+    }
+    if (++unreported == report_interval_) {
+      const size_t kTotal =
+          shared_expanded_.fetch_add(unreported, std::memory_order_relaxed) +
+          unreported;
+      unreported = 0;
+      if (options_.max_expanded_nodes != 0 &&
+          kTotal > options_.max_expanded_nodes) {
+        Stop(SearchTermination::NODE_LIMIT);
+        return false;
+      }
+    }
+    ++worker.stats.expanded_;
+    expanded_[kEntry.cell] = 1;
+    const int kNextG = kEntry.g_score + 1;
+    for (const int kOffset : neighbors_.Of(kEntry.cell)) {
+      const int kNext = kEntry.cell + kOffset;
+      const unsigned kOwner = owners_[kNext];
+      if (kOwner == id) {
+        Relax(worker, kNext, kNextG, kEntry.cell);
+      } else if (kNextG + Heuristic(kNext) < Incumbent()) {
+        Send(id, kOwner,
+             {.cell = kNext, .g_score = kNextG, .parent = kEntry.cell});
+      }
+    }
+    return true;
+  }
+
+  void Stop(SearchTermination termination) {
+    SearchTermination expected = SearchTermination::COMPLETED;
+    termination_.compare_exchange_strong(expected, termination,
+                                         std::memory_order_relaxed);
+    done_.store(true, std::memory_order_release);
+  }
+
+  // unfinished_work_ counts active workers plus queued messages. Only an
+  // active worker sends and an idle one rejoins before retiring what it
+  // received, so once it reaches zero no open list holds anything below the
+  // incumbent and nothing can add to one: the incumbent is optimal.
+  void Work(unsigned id) {
+    Worker& worker = workers_[id];
+    // The node limit is shared across workers; each budget only keeps the
+    // deadline and stop token.
+    SolveOptions local_options = options_;
+    local_options.max_expanded_nodes = 0;
+    SearchBudget budget(local_options);
+    size_t unreported = 0;
+    bool idle = false;
+    while (!done_.load(std::memory_order_acquire)) {
+      Receive(id, idle);
+      for (int round = 0; round < kExpansionsPerRound && HasWork(worker);
+           ++round) {
+        if (!Expand(id, budget, unreported)) {
+          return;
+        }
+      }
+      for (unsigned to = 0; to < worker.outbox.size(); ++to) {
+        if (worker.outbox[to] && !worker.outbox[to]->messages.empty()) {
+          Flush(to, worker.outbox[to]);
+        }
+      }
+      if (HasWork(worker)) {
+        continue;
+      }
+      if (!idle) {
+        idle = true;
+        if (unfinished_work_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          done_.store(true, std::memory_order_release);
+          return;
+        }
+      }
+      if (unfinished_work_.load(std::memory_order_acquire) == 0) {
+        done_.store(true, std::memory_order_release);
+        return;
+      }
+      if (!budget.Poll()) {
+        Stop(budget.Termination());
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  const MazeAdjacency& adjacency_;
+  const NeighborTable neighbors_;
+  const CellEndpoints endpoints_;
+  const GridPosition end_;
+  const SolveOptions& options_;
+  std::vector<std::uint8_t> owners_;
+  std::vector<int> g_scores_;
+  std::vector<int> parents_;
+  std::vector<std::uint8_t> expanded_;
+  std::vector<Worker> workers_;
+  const size_t report_interval_;
+  alignas(kCacheLine) std::atomic<int> incumbent_{kFarAway};
+  alignas(kCacheLine) std::atomic<std::int64_t> unfinished_work_;
+  alignas(kCacheLine) std::atomic<size_t> shared_expanded_{0};
+  std::atomic<bool> done_{false};
+  std::atomic<SearchTermination> termination_{SearchTermination::COMPLETED};
+};
+
+}  // namespace
+
+auto SolveParallelAStar(const MazeGrid& maze_grid, GridPosition start_node,
+                        GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  const PathEndpoints kEndpoints{.start = start_node, .end = end_node};
+  SearchBudget budget(options);
+  if (!budget.Poll()) {
+    return CreateStoppedResult(*kGridSize, kEndpoints, budget);
+  }
+  const MazeAdjacency kAdjacency(maze_grid);
+  const CellEndpoints kCells{.start = kAdjacency.IndexOf(start_node),
+                             .end = kAdjacency.IndexOf(end_node)};
+  const unsigned kWorkerCount = std::min(
+      kMaxWorkers,
+      options.search_threads == 0
+          ? std::max(1U, std::thread::hardware_concurrency())
+          : options.search_threads);
+  ParallelSearch search(kAdjacency, kCells, kWorkerCount, options);
+  search.Run();
+
+  // Workers record no frames; the result carries the final state only.
+  SearchResult result;
+  const bool kFound = search.Found();
+  SearchState state{.visited = search.Reached(),
+                    .parents = std::move(search.Parents())};
+  if (kFound) {
+    result.path_ =
+        ExtractCellPath(kAdjacency, state.parents, kCells.start, kCells.end);
+  } else if (search.Termination() != SearchTermination::COMPLETED) {
+    result.path_ = ExtractCellPath(
+        kAdjacency, state.parents, kCells.start,
+        ClosestReachedCell(kAdjacency, state, kEndpoints));
+  }
+  if (options.record_frames) {
+    auto visual_states = CreateStateGrid(*kGridSize, SolverCellState::NONE);
+    for (int cell = 0; cell < kAdjacency.CellCount(); ++cell) {
+      if (state.visited[cell] != 0) {
+        const GridPosition kPos = kAdjacency.PositionOf(cell);
+        visual_states[kPos.first][kPos.second] =
+            search.Expanded()[cell] != 0 ? SolverCellState::VISITED_PROC
+                                         : SolverCellState::FRONTIER;
+      }
+    }
+    for (const GridPosition& node : result.path_) {
+      visual_states[node.first][node.second] = SolverCellState::SOLUTION;
+    }
+    PushFrame(result, visual_states, result.path_);
+  }
+  result.found_ = kFound;
+  result.explored_ = ToBoolGrid(kAdjacency, state.visited);
+  result.termination_ = search.Termination();
+  result.stats_ = search.Stats();
+  return result;
+}
+
+}  // namespace MazeSolverDomain::detail
@@ -0,0 +1,85 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include <chrono>
+
+#include "domain/maze_landmarks.h"
+#include "domain/maze_search_kernel.h"
+#include "domain/maze_search_policies.h"
+
+namespace MazeSolverDomain::detail {
+
+namespace {
+
+// Runs the corridor-skipping variant of Policy when options ask for it.
+template <typename Policy>
+auto SolveWithCorridors(const MazeGrid& maze_grid, GridPosition start_node,
+                        GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  if (options.skip_corridors) {
+    return SolveWithPolicy<CorridorSkipping<Policy>>(maze_grid, start_node,
+                                                     end_node, options);
+  }
+  return SolveWithPolicy<Policy>(maze_grid, start_node, end_node, options);
+}
+
+}  // namespace
+
+auto SolveBfs(const MazeGrid& maze_grid, GridPosition start_node,
+              GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  // Once corridors collapse into longer edges a FIFO no longer yields
+  // shortest paths, so skipping BFS is the distance-ordered search.
+  if (options.skip_corridors) {
+    return SolveWithPolicy<CorridorSkipping<DijkstraPolicy>>(
+        maze_grid, start_node, end_node, options);
+  }
+  return SolveWithPolicy<BreadthFirstPolicy>(maze_grid, start_node, end_node,
+                                             options);
+}
+
+auto SolveDfs(const MazeGrid& maze_grid, GridPosition start_node,
+              GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  return SolveWithPolicy<DepthFirstPolicy>(maze_grid, start_node, end_node,
+                                           options);
+}
+
+auto SolveAStar(const MazeGrid& maze_grid, GridPosition start_node,
+                GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  if (options.landmarks != nullptr) {
+    return SolveAStarWithLandmarks(maze_grid, start_node, end_node,
+                                   *options.landmarks, options);
+  }
+  if (options.landmark_count > 0) {
+    const auto kBuildStart = std::chrono::steady_clock::now();
+    const LandmarkTable kLandmarks(MazeAdjacency(maze_grid),
+                                   options.landmark_count);
+    const double kBuildSeconds = std::chrono::duration<double>(
+                                     std::chrono::steady_clock::now() -
+                                     kBuildStart)
+                                     .count();
+    SearchResult result = SolveAStarWithLandmarks(
+        maze_grid, start_node, end_node, kLandmarks, options);
+    result.stats_.preprocess_seconds_ += kBuildSeconds;
+    return result;
+  }
+  return SolveWithCorridors<AStarPolicy>(maze_grid, start_node, end_node,
+                                         options);
+}
+
+auto SolveDijkstra(const MazeGrid& maze_grid, GridPosition start_node,
+                   GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  return SolveWithCorridors<DijkstraPolicy>(maze_grid, start_node, end_node,
+                                            options);
+}
+
+auto SolveGreedyBestFirst(const MazeGrid& maze_grid, GridPosition start_node,
+                          GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  return SolveWithPolicy<GreedyBestFirstPolicy>(maze_grid, start_node,
+                                                end_node, options);
+}
+
+}  // namespace MazeSolverDomain::detail
@@ -0,0 +1,60 @@
+#include "domain/maze_solver_algorithms.h"
+
+#include <chrono>
+#include <optional>
+
+#include "domain/maze_path_index.h"
+
+namespace MazeSolverDomain::detail {
+
+auto SolveTreeLca(const MazeGrid& maze_grid, GridPosition start_node,
+                  GridPosition end_node, const SolveOptions& options)
+    -> SearchResult {
+  const auto kGridSize = GetGridSize(maze_grid);
+  if (!kGridSize.has_value()) {
+    return {};
+  }
+  if (!IsValidPosition(start_node, *kGridSize) ||
+      !IsValidPosition(end_node, *kGridSize)) {
+    return {};
+  }
+  if (start_node == end_node) {
+    return CreateTrivialResult(*kGridSize, start_node);
+  }
+
+  // The index build has no per-cell hook; the deadline and stop token are
+  // checked around it.
+  const PathEndpoints kEndpoints{.start = start_node, .end = end_node};
+  SearchBudget budget(options);
+  if (!budget.Poll()) {
+    return CreateStoppedResult(*kGridSize, kEndpoints, budget);
+  }
+  const std::optional<TreePathIndex>* index = options.tree_index;
+  std::optional<TreePathIndex> built;
+  double build_seconds = 0.0;
+  if (index == nullptr ||
+      (index->has_value() && ((*index)->Height() != kGridSize->height ||
+                              (*index)->Width() != kGridSize->width))) {
+    const auto kBuildStart = std::chrono::steady_clock::now();
+    built = TreePathIndex::Build(maze_grid);
+    index = &built;
+    build_seconds = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - kBuildStart)
+                        .count();
+    if (!budget.Poll()) {
+      SearchResult result = CreateStoppedResult(*kGridSize, kEndpoints, budget);
+      result.stats_.preprocess_seconds_ = build_seconds;
+      return result;
+    }
+  }
+  // Braided or disconnected mazes have no unique path; search instead.
+  SearchResult result =
+      index->has_value()
+          ? CreatePathResult(*kGridSize, kEndpoints, true,
+                             (*index)->Path(start_node, end_node))
+          : SolveBfs(maze_grid, start_node, end_node, options);
+  result.stats_.preprocess_seconds_ = build_seconds;
+  return result;
+}
+
+}  // namespace MazeSolverDomain::detail
@@ -0,0 +1,107 @@
+#include "domain/maze_weighted_solver.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+
+#include "domain/maze_adjacency.h"
+#include "domain/maze_radix_heap.h"
+
+namespace MazeSolverDomain {
+
+namespace {
+
+constexpr int kNoCell = -1;
+constexpr std::uint32_t kUnreachedCost =
+    std::numeric_limits<std::uint32_t>::max();
+// Same neighbour order as the unweighted best-first solvers.
+constexpr std::array<int, MazeAdjacency::kDirectionCount> kNeighborOrder = {
+    0, 2, 3, 1};
+
+auto Manhattan(const MazeAdjacency& adjacency, int cell, GridPosition end)
+    -> std::uint32_t {
+  const GridPosition kPos = adjacency.PositionOf(cell);
+  return static_cast<std::uint32_t>(std::abs(kPos.first - end.first) +
+                                    std::abs(kPos.second - end.second));
+}
+
+}  // namespace
+
+auto SolveWeighted(const MazeDomain::MazeGrid& maze_grid,
+                   const MazeDomain::CellWeights& weights,
+                   GridPosition start_node, GridPosition end_node,
+                   SolverAlgorithmType algorithm_type) -> WeightedSearchResult {
+  WeightedSearchResult result;
+  const MazeAdjacency kAdjacency(maze_grid);
+  if (kAdjacency.CellCount() == 0 || weights.height() != kAdjacency.Height() ||
+      weights.width() != kAdjacency.Width()) {
+    return result;
+  }
+  const auto kInside = [&kAdjacency](GridPosition pos) -> bool {
+    return pos.first >= 0 && pos.first < kAdjacency.Height() &&
+           pos.second >= 0 && pos.second < kAdjacency.Width();
+  };
+  if (!kInside(start_node) || !kInside(end_node)) {
+    return result;
+  }
+
+  const bool kUsesHeuristic = algorithm_type == SolverAlgorithmType::ASTAR;
+  const std::uint32_t kHeuristicScale = weights.min_weight();
+  const auto kHeuristic = [&](int cell) -> std::uint32_t {
+    return kUsesHeuristic ? kHeuristicScale * Manhattan(kAdjacency, cell,
+                                                        end_node)
+                          : 0;
+  };
+
+  const NeighborTable kNeighbors(kAdjacency, kNeighborOrder);
+  const auto kCellCount = static_cast<size_t>(kAdjacency.CellCount());
+  std::vector<std::uint32_t> costs(kCellCount, kUnreachedCost);
+  std::vector<int> parents(kCellCount, kNoCell);
+  std::vector<bool> closed(kCellCount, false);
+  RadixHeap<int> frontier;
+
+  const int kStart = kAdjacency.IndexOf(start_node);
+  const int kEnd = kAdjacency.IndexOf(end_node);
+  costs[kStart] = 0;
+  frontier.Push(kHeuristic(kStart), kStart);
+
+  while (!frontier.Empty()) {
+    const int kCurrent = frontier.Pop();
+    if (closed[kCurrent]) {
+      continue;
+    }
+    closed[kCurrent] = true;
+    ++result.expanded_;
+    if (kCurrent == kEnd) {
+      result.found_ = true;
+      break;
+    }
+
+    for (const int kOffset : kNeighbors.Of(kCurrent)) {
+      const int kNext = kCurrent + kOffset;
+      if (closed[kNext]) {
+        continue;
+      }
+      const std::uint32_t kTentative =
+          costs[kCurrent] + weights.at_index(static_cast<size_t>(kNext));
+      if (kTentative < costs[kNext]) {
+        costs[kNext] = kTentative;
+        parents[kNext] = kCurrent;
+        frontier.Push(kTentative + kHeuristic(kNext), kNext);
+      }
+    }
+  }
+
+  if (!result.found_) {
+    return result;
+  }
+  result.cost_ = costs[kEnd];
+  for (int cell = kEnd; cell != kNoCell; cell = parents[cell]) {
+    result.path_.push_back(kAdjacency.PositionOf(cell));
+  }
+  std::ranges::reverse(result.path_);
+  return result;
+}
+
+}  // namespace MazeSolverDomain
@@ -0,0 +1,34 @@
+#ifndef MAZE_DOMAIN_MAZE_WEIGHTED_SOLVER_H
+#define MAZE_DOMAIN_MAZE_WEIGHTED_SOLVER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "domain/maze_cell_weights.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solver.h"
+
+namespace MazeSolverDomain {
+
+struct WeightedSearchResult {
+  bool found_ = false;
+  // Sum of the weights of every cell entered after the start.
+  std::uint64_t cost_ = 0;
+  std::vector<GridPosition> path_;
+  std::uint64_t expanded_ = 0;
+};
+
+// Cheapest path when stepping into a cell costs its weight. ASTAR uses
+// min_weight * Manhattan distance as a consistent heuristic; every other
+// algorithm type runs Dijkstra. Both pop from a monotone radix heap and keep
+// no frames, so they scale to very large mazes. The unweighted solvers are
+// untouched; weights that do not match the maze size give "not found".
+WeightedSearchResult SolveWeighted(const MazeDomain::MazeGrid& maze_grid,
+                                   const MazeDomain::CellWeights& weights,
+                                   GridPosition start_node,
+                                   GridPosition end_node,
+                                   SolverAlgorithmType algorithm_type);
+
+}  // namespace MazeSolverDomain
+
+#endif  // MAZE_DOMAIN_MAZE_WEIGHTED_SOLVER_H
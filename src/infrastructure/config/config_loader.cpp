@@ -1,5 +1,6 @@
 #include "config_loader.h"
 
+#include <array>
 #include <exception>
 #include <sstream>
 
@@ -14,6 +15,8 @@ constexpr int kDefaultMazeHeight = 10;
 constexpr int kDefaultUnitPixels = 15;
 constexpr size_t kHexColorLength = 6;
 constexpr int kHexBase = 16;
+constexpr size_t kQueryPairFields = 4;
+constexpr size_t kExitNodeFields = 2;
 
 auto DefaultConfig() -> Config::AppConfig {
   Config::AppConfig config;
@@ -61,6 +64,38 @@ auto ParseHexColorString(std::string hex_string,
   }
 }
 
+auto ParseQueryPair(const toml::node& node, Config::QueryPair& out) -> bool {
+  const auto* fields = node.as_array();
+  if (fields == nullptr || fields->size() != kQueryPairFields) {
+    return false;
+  }
+  std::array<int, kQueryPairFields> values{};
+  for (size_t index = 0; index < kQueryPairFields; ++index) {
+    auto value = (*fields)[index].value<int>();
+    if (!value) {
+      return false;
+    }
+    values[index] = *value;
+  }
+  out.start_node = {values[0], values[1]};
+  out.end_node = {values[2], values[3]};
+  return true;
+}
+
+auto ParseExitNode(const toml::node& node, std::pair<int, int>& out) -> bool {
+  const auto* fields = node.as_array();
+  if (fields == nullptr || fields->size() != kExitNodeFields) {
+    return false;
+  }
+  auto row = (*fields)[0].value<int>();
+  auto col = (*fields)[1].value<int>();
+  if (!row || !col) {
+    return false;
+  }
+  out = {*row, *col};
+  return true;
+}
+
 }  // namespace
 
 auto load_config(const std::string& filename) -> LoadResult {
@@ -96,6 +131,96 @@ auto load_config(const std::string& filename) -> LoadResult {
   int end_x =
       config["MazeConfig"]["EndNodeX"].value_or(result.config.maze.width - 1);
   result.config.maze.end_node = {end_y, end_x};
+  result.config.maze.hardest_endpoints =
+      config["MazeConfig"]["HardestEndpoints"].value_or(
+          result.config.maze.hardest_endpoints);
+
+  result.config.maze.query_pairs.clear();
+  if (auto* pairs = config["MazeConfig"]["QueryPairs"].as_array()) {
+    for (const auto& elem : *pairs) {
+      Config::QueryPair pair;
+      if (ParseQueryPair(elem, pair)) {
+        result.config.maze.query_pairs.push_back(pair);
+      } else {
+        result.warnings.emplace_back(
+            "Warning: QueryPairs entries must be [StartNodeY, StartNodeX, "
+            "EndNodeY, EndNodeX]. Ignoring malformed entry.");
+      }
+    }
+  }
+  result.config.maze.exit_nodes.clear();
+  if (auto* exits = config["MazeConfig"]["ExitNodes"].as_array()) {
+    for (const auto& elem : *exits) {
+      std::pair<int, int> exit_node;
+      if (ParseExitNode(elem, exit_node)) {
+        result.config.maze.exit_nodes.push_back(exit_node);
+      } else {
+        result.warnings.emplace_back(
+            "Warning: ExitNodes entries must be [NodeY, NodeX]. Ignoring "
+            "malformed entry.");
+      }
+    }
+  }
+  result.config.maze.batch_threads =
+      config["MazeConfig"]["BatchThreads"].value_or(
+          result.config.maze.batch_threads);
+  result.config.maze.distance_field =
+      config["MazeConfig"]["DistanceField"].value_or(
+          result.config.maze.distance_field);
+  result.config.maze.distance_field_threads =
+      config["MazeConfig"]["DistanceFieldThreads"].value_or(
+          result.config.maze.distance_field_threads);
+  result.config.maze.distance_matrix =
+      config["MazeConfig"]["DistanceMatrix"].value_or(
+          result.config.maze.distance_matrix);
+  result.config.maze.terrain_cost_max =
+      config["MazeConfig"]["TerrainCostMax"].value_or(
+          result.config.maze.terrain_cost_max);
+  result.config.maze.replan_wall_edits =
+      config["MazeConfig"]["ReplanWallEdits"].value_or(
+          result.config.maze.replan_wall_edits);
+  result.config.maze.out_of_core_walk =
+      config["MazeConfig"]["OutOfCoreWalk"].value_or(
+          result.config.maze.out_of_core_walk);
+  result.config.maze.flow_field_agents =
+      config["MazeConfig"]["FlowFieldAgents"].value_or(
+          result.config.maze.flow_field_agents);
+  result.config.maze.max_expanded_nodes =
+      config["MazeConfig"]["MaxExpandedNodes"].value_or(
+          result.config.maze.max_expanded_nodes);
+  result.config.maze.solve_time_limit_ms =
+      config["MazeConfig"]["SolveTimeLimitMs"].value_or(
+          result.config.maze.solve_time_limit_ms);
+  result.config.maze.max_frames =
+      config["MazeConfig"]["MaxFrames"].value_or(
+          result.config.maze.max_frames);
+  result.config.maze.skip_corridors =
+      config["MazeConfig"]["SkipCorridors"].value_or(
+          result.config.maze.skip_corridors);
+  result.config.maze.landmark_count =
+      config["MazeConfig"]["LandmarkCount"].value_or(
+          result.config.maze.landmark_count);
+  result.config.maze.cluster_size =
+      config["MazeConfig"]["ClusterSize"].value_or(
+          result.config.maze.cluster_size);
+  result.config.maze.search_threads =
+      config["MazeConfig"]["SearchThreads"].value_or(
+          result.config.maze.search_threads);
+  result.config.maze.dead_end_prefilter =
+      config["MazeConfig"]["DeadEndPrefilter"].value_or(
+          result.config.maze.dead_end_prefilter);
+  result.config.maze.compact_paths =
+      config["MazeConfig"]["CompactPaths"].value_or(
+          result.config.maze.compact_paths);
+  result.config.maze.solve_cache_entries =
+      config["MazeConfig"]["SolveCacheEntries"].value_or(
+          result.config.maze.solve_cache_entries);
+  result.config.maze.solve_cache_max_mib =
+      config["MazeConfig"]["SolveCacheMaxMiB"].value_or(
+          result.config.maze.solve_cache_max_mib);
+  result.config.maze.solve_cache_dir =
+      config["MazeConfig"]["SolveCacheDir"].value_or(
+          result.config.maze.solve_cache_dir);
 
   result.config.maze.generation_algorithms.clear();
   if (auto* algos = config["MazeConfig"]["GenerationAlgorithms"].as_array()) {
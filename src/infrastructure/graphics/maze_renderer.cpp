@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <optional>
 #include <sstream>
@@ -33,14 +34,30 @@ auto SolverFolderName(SolverAlgorithmType algorithm_type) -> std::string {
   switch (algorithm_type) {
     case SolverAlgorithmType::BFS:
       return "bfs";
+    case SolverAlgorithmType::BITBOARD_BFS:
+      return "bitboard_bfs";
     case SolverAlgorithmType::DFS:
       return "dfs";
     case SolverAlgorithmType::ASTAR:
       return "astar";
+    case SolverAlgorithmType::PARALLEL_ASTAR:
+      return "parallel_astar";
     case SolverAlgorithmType::DIJKSTRA:
       return "dijkstra";
     case SolverAlgorithmType::GREEDY_BEST_FIRST:
       return "greedy_best_first";
+    case SolverAlgorithmType::JUNCTION_GRAPH:
+      return "junction_graph";
+    case SolverAlgorithmType::TREE_LCA:
+      return "tree_lca";
+    case SolverAlgorithmType::HIERARCHICAL:
+      return "hierarchical";
+    case SolverAlgorithmType::DEAD_END_FILLING:
+      return "dead_end_filling";
+    case SolverAlgorithmType::WALL_FOLLOWER:
+      return "wall_follower";
+    case SolverAlgorithmType::TREMAUX:
+      return "tremaux";
   }
   return "solver";
 }
@@ -302,6 +319,38 @@ void PaintPathCorridors(std::vector<unsigned char>& pixels,
   }
 }
 
+// Plain-text counters next to the frames, so runs of one solver over
+// different generation algorithms can be compared folder by folder.
+auto WriteStatsReport(const fs::path& folder_path,
+                      const MazeSolverDomain::SearchResult& result,
+                      std::string& error) -> bool {
+  const fs::path kReportPath = folder_path / "search_stats.txt";
+  std::ofstream report(kReportPath);
+  if (!report) {
+    error = "Failed to write search stats: " + kReportPath.string();
+    return false;
+  }
+  const auto& stats = result.stats_;
+  report << "found=" << (result.found_ ? "true" : "false") << "\n"
+         << "termination="
+         << MazeSolverDomain::TerminationName(result.termination_) << "\n"
+         << "path_length=" << result.PathCells() << "\n"
+         << "expanded=" << stats.expanded_ << "\n"
+         << "pushed=" << stats.pushed_ << "\n"
+         << "stale_pops=" << stats.stale_pops_ << "\n"
+         << "peak_frontier=" << stats.peak_frontier_ << "\n"
+         << "skipped=" << stats.skipped_ << "\n"
+         << "landmarks=" << stats.landmarks_ << "\n"
+         << "landmark_bytes=" << stats.landmark_bytes_ << "\n"
+         << "filled=" << stats.filled_ << "\n"
+         << "frames_recorded=" << stats.frames_recorded_ << "\n"
+         << "frame_bytes=" << stats.frame_bytes_ << "\n"
+         << "search_seconds=" << stats.seconds_ << "\n"
+         << "preprocess_seconds=" << stats.preprocess_seconds_ << "\n"
+         << "from_cache=" << (stats.from_cache_ ? "true" : "false") << "\n";
+  return static_cast<bool>(report);
+}
+
 auto BuildFramePath(const fs::path& folder_path, int step_count) -> fs::path {
   std::stringstream path_stream;
   path_stream << folder_path.string() << "/frame_"
@@ -415,6 +464,12 @@ auto RenderSearchResult(const SearchResult& result,
     render_result.frames_written++;
   }
 
+  std::string report_error;
+  if (!WriteStatsReport(folder_path, result, report_error)) {
+    render_result.ok = false;
+    render_result.error = report_error;
+    return render_result;
+  }
   render_result.output_folder = folder_path.string();
   return render_result;
 }
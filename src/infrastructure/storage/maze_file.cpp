@@ -0,0 +1,687 @@
+#include "infrastructure/storage/maze_file.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MazeStorage {
+
+namespace {
+
+auto PackCell(const MazeDomain::MazeCell& cell) -> std::uint8_t {
+  std::uint8_t nibble = 0;
+  for (int wall = 0; wall < MazeDomain::kWallCount; ++wall) {
+    if (cell.walls[wall]) {
+      nibble = static_cast<std::uint8_t>(nibble | (1U << wall));
+    }
+  }
+  return nibble;
+}
+
+void PutUint32(char* header, size_t offset, std::uint32_t value) {
+  for (size_t byte = 0; byte < 4; ++byte) {
+    header[offset + byte] = static_cast<char>((value >> (byte * 8)) & 0xFFU);
+  }
+}
+
+auto GetUint32(const std::uint8_t* data, size_t offset) -> std::uint32_t {
+  std::uint32_t value = 0;
+  for (size_t byte = 0; byte < 4; ++byte) {
+    value |= static_cast<std::uint32_t>(data[offset + byte]) << (byte * 8);
+  }
+  return value;
+}
+
+auto GetUint64(const std::uint8_t* data, size_t offset) -> std::uint64_t {
+  std::uint64_t value = 0;
+  for (size_t byte = 0; byte < 8; ++byte) {
+    value |= static_cast<std::uint64_t>(data[offset + byte]) << (byte * 8);
+  }
+  return value;
+}
+
+void AppendUint32(std::vector<char>& bytes, std::uint32_t value) {
+  for (size_t byte = 0; byte < 4; ++byte) {
+    bytes.push_back(static_cast<char>((value >> (byte * 8)) & 0xFFU));
+  }
+}
+
+void AppendUint64(std::vector<char>& bytes, std::uint64_t value) {
+  for (size_t byte = 0; byte < 8; ++byte) {
+    bytes.push_back(static_cast<char>((value >> (byte * 8)) & 0xFFU));
+  }
+}
+
+void AppendWords(std::vector<char>& bytes,
+                 const std::vector<std::uint64_t>& words) {
+  for (const std::uint64_t kWord : words) {
+    AppendUint64(bytes, kWord);
+  }
+}
+
+void AppendPath(std::vector<char>& bytes,
+                const std::vector<MazeSolverDomain::GridPosition>& path) {
+  AppendUint64(bytes, path.size());
+  for (const auto& [row, col] : path) {
+    AppendUint32(bytes, static_cast<std::uint32_t>(row));
+    AppendUint32(bytes, static_cast<std::uint32_t>(col));
+  }
+}
+
+// Bounds-checked cursor over a loaded file. A read past the end returns
+// zeros and clears Ok() for good.
+class ByteReader {
+ public:
+  explicit ByteReader(const std::vector<std::uint8_t>& bytes)
+      : bytes_(bytes) {}
+
+  auto Uint32() -> std::uint32_t {
+    return Take(4) ? GetUint32(bytes_.data(), offset_ - 4) : 0;
+  }
+  auto Uint64() -> std::uint64_t {
+    return Take(8) ? GetUint64(bytes_.data(), offset_ - 8) : 0;
+  }
+  auto Bytes(std::uint64_t size) -> const std::uint8_t* {
+    return Take(size) ? bytes_.data() + (offset_ - size) : nullptr;
+  }
+  auto Remaining() const -> size_t { return bytes_.size() - offset_; }
+  auto Ok() const -> bool { return ok_; }
+
+ private:
+  auto Take(std::uint64_t size) -> bool {
+    if (!ok_ || Remaining() < size) {
+      ok_ = false;
+      return false;
+    }
+    offset_ += static_cast<size_t>(size);
+    return true;
+  }
+
+  const std::vector<std::uint8_t>& bytes_;
+  size_t offset_ = 0;
+  bool ok_ = true;
+};
+
+// Cells outside a `height` x `width` grid make the whole path invalid.
+auto ReadPath(ByteReader& reader, int height, int width)
+    -> std::optional<std::vector<MazeSolverDomain::GridPosition>> {
+  const std::uint64_t kCount = reader.Uint64();
+  if (!reader.Ok() || kCount > reader.Remaining() / 8) {
+    return std::nullopt;
+  }
+  std::vector<MazeSolverDomain::GridPosition> path;
+  path.reserve(static_cast<size_t>(kCount));
+  for (std::uint64_t index = 0; index < kCount; ++index) {
+    const std::uint32_t kRow = reader.Uint32();
+    const std::uint32_t kCol = reader.Uint32();
+    if (kRow >= static_cast<std::uint32_t>(height) ||
+        kCol >= static_cast<std::uint32_t>(width)) {
+      return std::nullopt;
+    }
+    path.emplace_back(static_cast<int>(kRow), static_cast<int>(kCol));
+  }
+  return path;
+}
+
+// The whole file in one read; nullopt if it cannot be opened or read.
+auto ReadWholeFile(const std::filesystem::path& path)
+    -> std::optional<std::vector<std::uint8_t>> {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    return std::nullopt;
+  }
+  std::vector<std::uint8_t> bytes(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(bytes.data()),
+          static_cast<std::streamsize>(bytes.size()));
+  if (!in) {
+    return std::nullopt;
+  }
+  return bytes;
+}
+
+auto Failure(std::string error) -> MazeFileResult {
+  return {.ok = false, .error = std::move(error)};
+}
+
+}  // namespace
+
+auto MazeFileWriter::Open(const std::filesystem::path& path, int height,
+                          int width) -> MazeFileResult {
+  if (height <= 0 || width <= 0) {
+    return Failure("Invalid maze dimensions for maze file.");
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    return Failure("Failed to open maze file for writing: " + path.string());
+  }
+  height_ = height;
+  width_ = width;
+  rows_written_ = 0;
+  has_pending_ = false;
+
+  std::array<char, kMazeFileHeaderSize> header{};
+  std::memcpy(header.data(), kMazeFileMagic, sizeof(kMazeFileMagic));
+  PutUint32(header.data(), 4, kMazeFileVersion);
+  PutUint32(header.data(), 8, static_cast<std::uint32_t>(height));
+  PutUint32(header.data(), 12, static_cast<std::uint32_t>(width));
+  out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+  return out_ ? MazeFileResult{} : Failure("Failed to write maze file header.");
+}
+
+auto MazeFileWriter::AppendRow(const std::vector<MazeDomain::MazeCell>& row)
+    -> MazeFileResult {
+  if (!out_.is_open()) {
+    return Failure("Maze file is not open.");
+  }
+  if (static_cast<int>(row.size()) != width_ || rows_written_ >= height_) {
+    return Failure("Maze file row does not match the declared dimensions.");
+  }
+  std::vector<char> packed;
+  packed.reserve((row.size() / 2) + 1);
+  for (const auto& cell : row) {
+    const std::uint8_t kNibble = PackCell(cell);
+    if (has_pending_) {
+      packed.push_back(static_cast<char>(pending_ | (kNibble << 4U)));
+      has_pending_ = false;
+    } else {
+      pending_ = kNibble;
+      has_pending_ = true;
+    }
+  }
+  out_.write(packed.data(), static_cast<std::streamsize>(packed.size()));
+  ++rows_written_;
+  return out_ ? MazeFileResult{} : Failure("Failed to write maze file row.");
+}
+
+auto MazeFileWriter::Close() -> MazeFileResult {
+  if (!out_.is_open()) {
+    return Failure("Maze file is not open.");
+  }
+  if (has_pending_) {
+    const char kLast = static_cast<char>(pending_);
+    out_.write(&kLast, 1);
+    has_pending_ = false;
+  }
+  out_.close();
+  if (rows_written_ != height_) {
+    return Failure("Maze file closed after " + std::to_string(rows_written_) +
+                   " of " + std::to_string(height_) + " rows.");
+  }
+  return out_ ? MazeFileResult{} : Failure("Failed to finish maze file.");
+}
+
+auto WriteMazeFile(const std::filesystem::path& path,
+                   const MazeDomain::MazeGrid& maze_grid) -> MazeFileResult {
+  const int kHeight = static_cast<int>(maze_grid.size());
+  const int kWidth =
+      maze_grid.empty() ? 0 : static_cast<int>(maze_grid.front().size());
+  MazeFileWriter writer;
+  MazeFileResult result = writer.Open(path, kHeight, kWidth);
+  for (size_t row = 0; result.ok && row < maze_grid.size(); ++row) {
+    result = writer.AppendRow(maze_grid[row]);
+  }
+  return result.ok ? writer.Close() : result;
+}
+
+auto WriteFlowFieldFile(const std::filesystem::path& path,
+                        const MazeSolverDomain::FlowField& field)
+    -> MazeFileResult {
+  if (field.height_ <= 0 || field.width_ <= 0) {
+    return Failure("Invalid flow field dimensions.");
+  }
+  std::vector<char> bytes(kFlowFieldFileHeaderSize, 0);
+  std::memcpy(bytes.data(), kFlowFieldFileMagic, sizeof(kFlowFieldFileMagic));
+  PutUint32(bytes.data(), 4, kFlowFieldFileVersion);
+  PutUint32(bytes.data(), 8, static_cast<std::uint32_t>(field.height_));
+  PutUint32(bytes.data(), 12, static_cast<std::uint32_t>(field.width_));
+  PutUint32(bytes.data(), 16, static_cast<std::uint32_t>(field.goal_.first));
+  PutUint32(bytes.data(), 20, static_cast<std::uint32_t>(field.goal_.second));
+  AppendWords(bytes, field.reached_);
+  AppendWords(bytes, field.directions_);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return Failure("Failed to open flow field file for writing: " +
+                   path.string());
+  }
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  return out ? MazeFileResult{}
+             : Failure("Failed to write flow field file: " + path.string());
+}
+
+auto ReadFlowFieldFile(const std::filesystem::path& path, std::string& error)
+    -> std::optional<MazeSolverDomain::FlowField> {
+  const auto kFile = ReadWholeFile(path);
+  if (!kFile) {
+    error = "Failed to open flow field file: " + path.string();
+    return std::nullopt;
+  }
+  const std::vector<std::uint8_t>& kBytes = *kFile;
+  if (kBytes.size() < kFlowFieldFileHeaderSize ||
+      std::memcmp(kBytes.data(), kFlowFieldFileMagic,
+                  sizeof(kFlowFieldFileMagic)) != 0 ||
+      GetUint32(kBytes.data(), 4) != kFlowFieldFileVersion) {
+    error = "Not a flow field file (bad magic or version): " + path.string();
+    return std::nullopt;
+  }
+
+  constexpr auto kMaxDimension =
+      static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+  const std::uint32_t kHeight = GetUint32(kBytes.data(), 8);
+  const std::uint32_t kWidth = GetUint32(kBytes.data(), 12);
+  const std::uint32_t kGoalRow = GetUint32(kBytes.data(), 16);
+  const std::uint32_t kGoalCol = GetUint32(kBytes.data(), 20);
+  const std::uint64_t kCells = static_cast<std::uint64_t>(kHeight) * kWidth;
+  const std::uint64_t kReachedWords = (kCells + 63) / 64;
+  const std::uint64_t kDirectionWords =
+      (kCells + MazeSolverDomain::FlowField::kCellsPerWord - 1) /
+      MazeSolverDomain::FlowField::kCellsPerWord;
+  if (kHeight == 0 || kWidth == 0 || kHeight > kMaxDimension ||
+      kWidth > kMaxDimension || kGoalRow >= kHeight || kGoalCol >= kWidth ||
+      kBytes.size() - kFlowFieldFileHeaderSize !=
+          (kReachedWords + kDirectionWords) * 8) {
+    error = "Flow field file header does not match its size: " + path.string();
+    return std::nullopt;
+  }
+
+  MazeSolverDomain::FlowField field;
+  field.height_ = static_cast<int>(kHeight);
+  field.width_ = static_cast<int>(kWidth);
+  field.goal_ = {static_cast<int>(kGoalRow), static_cast<int>(kGoalCol)};
+  size_t offset = kFlowFieldFileHeaderSize;
+  field.reached_.resize(kReachedWords);
+  for (std::uint64_t& word : field.reached_) {
+    word = GetUint64(kBytes.data(), offset);
+    field.stats_.reached_cells_ += static_cast<std::uint64_t>(
+        std::popcount(word));
+    offset += 8;
+  }
+  field.directions_.resize(kDirectionWords);
+  for (std::uint64_t& word : field.directions_) {
+    word = GetUint64(kBytes.data(), offset);
+    offset += 8;
+  }
+  return field;
+}
+
+auto WriteSolveCacheFile(const std::filesystem::path& path,
+                         const MazeSolverDomain::SolveCacheKey& key,
+                         const MazeSolverDomain::SearchResult& result,
+                         int height, int width) -> MazeFileResult {
+  if (height <= 0 || width <= 0) {
+    return Failure("Invalid maze dimensions for solve cache file.");
+  }
+  const auto kHeightSize = static_cast<size_t>(height);
+  const auto kWidthSize = static_cast<size_t>(width);
+  const auto kMatchesGrid = [kHeightSize, kWidthSize](const auto& grid) {
+    return grid.size() == kHeightSize &&
+           std::all_of(grid.begin(), grid.end(),
+                       [kWidthSize](const auto& row) {
+                         return row.size() == kWidthSize;
+                       });
+  };
+  const bool kHasExplored = !result.explored_.empty();
+  if (kHasExplored && !kMatchesGrid(result.explored_)) {
+    return Failure("Explored cells do not match the grid size.");
+  }
+
+  std::vector<char> bytes(std::begin(kSolveCacheFileMagic),
+                          std::end(kSolveCacheFileMagic));
+  bytes.reserve(result.frames_.size() * kHeightSize * kWidthSize +
+                (result.path_.size() * 8) + 256);
+  AppendUint32(bytes, kSolveCacheFileVersion);
+  AppendUint32(bytes, static_cast<std::uint32_t>(height));
+  AppendUint32(bytes, static_cast<std::uint32_t>(width));
+  AppendUint64(bytes, key.maze_);
+  AppendUint64(bytes, key.options_);
+  AppendUint32(bytes, static_cast<std::uint32_t>(key.start_.first));
+  AppendUint32(bytes, static_cast<std::uint32_t>(key.start_.second));
+  AppendUint32(bytes, static_cast<std::uint32_t>(key.end_.first));
+  AppendUint32(bytes, static_cast<std::uint32_t>(key.end_.second));
+  AppendUint32(bytes, static_cast<std::uint32_t>(key.algorithm_));
+
+  const bool kHasCompactPath = !result.compact_path_.Empty();
+  AppendUint32(bytes, (result.found_ ? 1U : 0U) |
+                          (kHasCompactPath ? 2U : 0U) |
+                          (kHasExplored ? 4U : 0U));
+  AppendUint32(bytes, static_cast<std::uint32_t>(result.termination_));
+  const auto& stats = result.stats_;
+  for (const size_t kCounter :
+       {stats.expanded_, stats.pushed_, stats.stale_pops_,
+        stats.peak_frontier_, stats.skipped_, stats.landmarks_,
+        stats.landmark_bytes_, stats.filled_, stats.frames_recorded_,
+        stats.frame_bytes_}) {
+    AppendUint64(bytes, kCounter);
+  }
+  AppendUint64(bytes, std::bit_cast<std::uint64_t>(stats.seconds_));
+
+  AppendPath(bytes, result.path_);
+  if (kHasCompactPath) {
+    const auto kStart = result.compact_path_.Start();
+    const auto kRuns = result.compact_path_.Runs();
+    AppendUint32(bytes, static_cast<std::uint32_t>(kStart.first));
+    AppendUint32(bytes, static_cast<std::uint32_t>(kStart.second));
+    AppendUint64(bytes, kRuns.size());
+    bytes.insert(bytes.end(), kRuns.begin(), kRuns.end());
+  }
+  if (kHasExplored) {
+    std::vector<std::uint64_t> words((kHeightSize * kWidthSize + 63) / 64, 0);
+    size_t cell = 0;
+    for (const auto& row : result.explored_) {
+      for (const bool kExplored : row) {
+        words[cell / 64] |= static_cast<std::uint64_t>(kExplored)
+                            << (cell % 64);
+        ++cell;
+      }
+    }
+    AppendWords(bytes, words);
+  }
+  AppendUint64(bytes, result.frames_.size());
+  for (const auto& frame : result.frames_) {
+    if (!kMatchesGrid(frame.visual_states_)) {
+      return Failure("Search frame does not match the grid size.");
+    }
+    for (const auto& row : frame.visual_states_) {
+      const size_t kOffset = bytes.size();
+      bytes.resize(kOffset + row.size());
+      std::transform(row.begin(), row.end(), bytes.begin() + kOffset,
+                     [](MazeSolverDomain::SolverCellState state) {
+                       return static_cast<char>(state);
+                     });
+    }
+    AppendPath(bytes, frame.current_path_);
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return Failure("Failed to open solve cache file for writing: " +
+                   path.string());
+  }
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  return out ? MazeFileResult{}
+             : Failure("Failed to write solve cache file: " + path.string());
+}
+
+auto ReadSolveCacheFile(const std::filesystem::path& path,
+                        const MazeSolverDomain::SolveCacheKey& key, int height,
+                        int width, std::string& error)
+    -> std::optional<MazeSolverDomain::SearchResult> {
+  using MazeSolverDomain::GridPosition;
+  const auto kFile = ReadWholeFile(path);
+  if (!kFile) {
+    error = "Failed to open solve cache file: " + path.string();
+    return std::nullopt;
+  }
+  ByteReader reader(*kFile);
+  const std::uint8_t* magic = reader.Bytes(sizeof(kSolveCacheFileMagic));
+  if (magic == nullptr ||
+      std::memcmp(magic, kSolveCacheFileMagic,
+                  sizeof(kSolveCacheFileMagic)) != 0 ||
+      reader.Uint32() != kSolveCacheFileVersion) {
+    error = "Not a solve cache file (bad magic or version): " + path.string();
+    return std::nullopt;
+  }
+  const auto kReadPosition = [&reader]() -> GridPosition {
+    const auto kRow = static_cast<int>(reader.Uint32());
+    return {kRow, static_cast<int>(reader.Uint32())};
+  };
+  const auto kHeight = static_cast<int>(reader.Uint32());
+  const auto kWidth = static_cast<int>(reader.Uint32());
+  MazeSolverDomain::SolveCacheKey stored;
+  stored.maze_ = reader.Uint64();
+  stored.options_ = reader.Uint64();
+  stored.start_ = kReadPosition();
+  stored.end_ = kReadPosition();
+  stored.algorithm_ =
+      static_cast<MazeSolverDomain::SolverAlgorithmType>(reader.Uint32());
+  if (!reader.Ok() || height <= 0 || width <= 0 || kHeight != height ||
+      kWidth != width || stored != key) {
+    error = "Solve cache file was written for another query: " + path.string();
+    return std::nullopt;
+  }
+
+  const auto kCorrupt = [&error, &path]() {
+    error = "Solve cache file is damaged: " + path.string();
+    return std::nullopt;
+  };
+  MazeSolverDomain::SearchResult result;
+  const std::uint32_t kFlags = reader.Uint32();
+  const std::uint32_t kTermination = reader.Uint32();
+  if (kTermination >
+      static_cast<std::uint32_t>(
+          MazeSolverDomain::SearchTermination::CANCELLED)) {
+    return kCorrupt();
+  }
+  result.found_ = (kFlags & 1U) != 0;
+  result.termination_ =
+      static_cast<MazeSolverDomain::SearchTermination>(kTermination);
+  auto& stats = result.stats_;
+  for (size_t* counter :
+       {&stats.expanded_, &stats.pushed_, &stats.stale_pops_,
+        &stats.peak_frontier_, &stats.skipped_, &stats.landmarks_,
+        &stats.landmark_bytes_, &stats.filled_, &stats.frames_recorded_,
+        &stats.frame_bytes_}) {
+    *counter = static_cast<size_t>(reader.Uint64());
+  }
+  stats.seconds_ = std::bit_cast<double>(reader.Uint64());
+
+  auto path_cells = ReadPath(reader, height, width);
+  if (!path_cells) {
+    return kCorrupt();
+  }
+  result.path_ = std::move(*path_cells);
+  if ((kFlags & 2U) != 0) {
+    const GridPosition kStart = kReadPosition();
+    const std::uint64_t kRunCount = reader.Uint64();
+    const std::uint8_t* runs = reader.Bytes(kRunCount);
+    if (runs == nullptr) {
+      return kCorrupt();
+    }
+    auto compact = MazeSolverDomain::CompactPath::FromRuns(
+        kStart, {runs, static_cast<size_t>(kRunCount)});
+    if (!compact) {
+      return kCorrupt();
+    }
+    result.compact_path_ = std::move(*compact);
+  }
+  const auto kHeightSize = static_cast<size_t>(height);
+  const auto kWidthSize = static_cast<size_t>(width);
+  if ((kFlags & 4U) != 0) {
+    result.explored_.assign(kHeightSize, std::vector<bool>(kWidthSize));
+    size_t cell = 0;
+    std::uint64_t word = 0;
+    for (auto& row : result.explored_) {
+      for (size_t col = 0; col < kWidthSize; ++col, ++cell) {
+        if (cell % 64 == 0) {
+          word = reader.Uint64();
+        }
+        row[col] = ((word >> (cell % 64)) & 1U) != 0;
+      }
+    }
+  }
+
+  constexpr auto kMaxState =
+      static_cast<std::uint8_t>(MazeSolverDomain::SolverCellState::SOLUTION);
+  const std::uint64_t kFrameCount = reader.Uint64();
+  if (!reader.Ok() ||
+      kFrameCount > reader.Remaining() / (kHeightSize * kWidthSize)) {
+    return kCorrupt();
+  }
+  result.frames_.resize(static_cast<size_t>(kFrameCount));
+  for (auto& frame : result.frames_) {
+    const std::uint8_t* states = reader.Bytes(kHeightSize * kWidthSize);
+    if (states == nullptr) {
+      return kCorrupt();
+    }
+    frame.visual_states_.assign(
+        kHeightSize,
+        std::vector<MazeSolverDomain::SolverCellState>(kWidthSize));
+    for (auto& row : frame.visual_states_) {
+      if (*std::max_element(states, states + kWidthSize) > kMaxState) {
+        return kCorrupt();
+      }
+      std::transform(states, states + kWidthSize, row.begin(),
+                     [](std::uint8_t state) {
+                       return static_cast<MazeSolverDomain::SolverCellState>(
+                           state);
+                     });
+      states += kWidthSize;
+    }
+    auto current_path = ReadPath(reader, height, width);
+    if (!current_path) {
+      return kCorrupt();
+    }
+    frame.current_path_ = std::move(*current_path);
+  }
+  if (!reader.Ok() || reader.Remaining() != 0) {
+    return kCorrupt();
+  }
+  return result;
+}
+
+auto MappedMazeFile::Open(const std::filesystem::path& path,
+                          std::string& error) -> std::optional<MappedMazeFile> {
+  MappedMazeFile file;
+#ifdef _WIN32
+  HANDLE file_handle =
+      CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    error = "Failed to open maze file: " + path.string();
+    return std::nullopt;
+  }
+  file.file_handle_ = file_handle;
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file_handle, &size)) {
+    error = "Failed to read maze file size: " + path.string();
+    return std::nullopt;
+  }
+  file.mapped_size_ = static_cast<size_t>(size.QuadPart);
+  if (file.mapped_size_ < kMazeFileHeaderSize) {
+    error = "Maze file is too small: " + path.string();
+    return std::nullopt;
+  }
+  HANDLE mapping_handle =
+      CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_handle == nullptr) {
+    error = "Failed to map maze file: " + path.string();
+    return std::nullopt;
+  }
+  file.mapping_handle_ = mapping_handle;
+  file.base_ = static_cast<const std::uint8_t*>(
+      MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+  if (file.base_ == nullptr) {
+    error = "Failed to map maze file: " + path.string();
+    return std::nullopt;
+  }
+#else
+  const int kFd = ::open(path.c_str(), O_RDONLY);
+  if (kFd < 0) {
+    error = "Failed to open maze file: " + path.string();
+    return std::nullopt;
+  }
+  struct stat file_stat {};
+  if (::fstat(kFd, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < kMazeFileHeaderSize) {
+    ::close(kFd);
+    error = "Maze file is too small or unreadable: " + path.string();
+    return std::nullopt;
+  }
+  file.mapped_size_ = static_cast<size_t>(file_stat.st_size);
+  void* mapping =
+      ::mmap(nullptr, file.mapped_size_, PROT_READ, MAP_SHARED, kFd, 0);
+  ::close(kFd);
+  if (mapping == MAP_FAILED) {
+    error = "Failed to map maze file: " + path.string();
+    return std::nullopt;
+  }
+  file.base_ = static_cast<const std::uint8_t*>(mapping);
+#endif
+
+  if (std::memcmp(file.base_, kMazeFileMagic, sizeof(kMazeFileMagic)) != 0 ||
+      GetUint32(file.base_, 4) != kMazeFileVersion) {
+    error = "Not a packed maze file (bad magic or version): " + path.string();
+    return std::nullopt;
+  }
+  constexpr int kMaxDimension = std::numeric_limits<int>::max();
+  const std::uint32_t kHeight = GetUint32(file.base_, 8);
+  const std::uint32_t kWidth = GetUint32(file.base_, 12);
+  const std::uint64_t kCellBytes =
+      ((static_cast<std::uint64_t>(kHeight) * kWidth) + 1) / 2;
+  if (kHeight == 0 || kWidth == 0 ||
+      kHeight > static_cast<std::uint32_t>(kMaxDimension) ||
+      kWidth > static_cast<std::uint32_t>(kMaxDimension) ||
+      file.mapped_size_ - kMazeFileHeaderSize < kCellBytes) {
+    error = "Maze file header does not match its size: " + path.string();
+    return std::nullopt;
+  }
+  file.height_ = static_cast<int>(kHeight);
+  file.width_ = static_cast<int>(kWidth);
+  file.cells_ = file.base_ + kMazeFileHeaderSize;
+  return file;
+}
+
+MappedMazeFile::MappedMazeFile(MappedMazeFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+auto MappedMazeFile::operator=(MappedMazeFile&& other) noexcept
+    -> MappedMazeFile& {
+  if (this != &other) {
+    Release();
+    base_ = std::exchange(other.base_, nullptr);
+    cells_ = std::exchange(other.cells_, nullptr);
+    mapped_size_ = std::exchange(other.mapped_size_, 0);
+    height_ = std::exchange(other.height_, 0);
+    width_ = std::exchange(other.width_, 0);
+#ifdef _WIN32
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+  }
+  return *this;
+}
+
+MappedMazeFile::~MappedMazeFile() { Release(); }
+
+void MappedMazeFile::Release() {
+#ifdef _WIN32
+  if (base_ != nullptr) {
+    UnmapViewOfFile(base_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(file_handle_);
+  }
+  file_handle_ = nullptr;
+  mapping_handle_ = nullptr;
+#else
+  if (base_ != nullptr) {
+    ::munmap(const_cast<std::uint8_t*>(base_), mapped_size_);
+  }
+#endif
+  base_ = nullptr;
+  cells_ = nullptr;
+  mapped_size_ = 0;
+}
+
+}  // namespace MazeStorage
@@ -0,0 +1,126 @@
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "domain/maze_flow_field.h"
+#include "domain/maze_grid.h"
+#include "domain/maze_solve_cache.h"
+#include "domain/maze_solver.h"
+
+namespace MazeStorage {
+
+// Packed maze file: a 16-byte header ("MZG4", format version, height, width
+// as little-endian uint32) followed by one nibble per cell in row-major
+// order, low nibble first. Bit `w` of a nibble is MazeCell::walls[w].
+inline constexpr char kMazeFileMagic[4] = {'M', 'Z', 'G', '4'};
+inline constexpr std::uint32_t kMazeFileVersion = 1;
+inline constexpr size_t kMazeFileHeaderSize = 16;
+
+struct MazeFileResult {
+  bool ok = true;
+  std::string error;
+};
+
+// Streams a maze to disk one row at a time, so mazes larger than memory can
+// be produced without ever holding a full MazeGrid.
+class MazeFileWriter {
+ public:
+  MazeFileResult Open(const std::filesystem::path& path, int height,
+                      int width);
+  MazeFileResult AppendRow(const std::vector<MazeDomain::MazeCell>& row);
+  MazeFileResult Close();
+
+ private:
+  std::ofstream out_;
+  int height_ = 0;
+  int width_ = 0;
+  int rows_written_ = 0;
+  std::uint8_t pending_ = 0;
+  bool has_pending_ = false;
+};
+
+MazeFileResult WriteMazeFile(const std::filesystem::path& path,
+                             const MazeDomain::MazeGrid& maze_grid);
+
+// Flow field file: a 24-byte header ("MZF1", format version, height, width,
+// goal row, goal column as little-endian uint32), then FlowField::reached_
+// and FlowField::directions_ as little-endian uint64 words.
+inline constexpr char kFlowFieldFileMagic[4] = {'M', 'Z', 'F', '1'};
+inline constexpr std::uint32_t kFlowFieldFileVersion = 1;
+inline constexpr size_t kFlowFieldFileHeaderSize = 24;
+
+MazeFileResult WriteFlowFieldFile(const std::filesystem::path& path,
+                                  const MazeSolverDomain::FlowField& field);
+// Stats other than reached_cells_ are not stored and come back zero.
+std::optional<MazeSolverDomain::FlowField> ReadFlowFieldFile(
+    const std::filesystem::path& path, std::string& error);
+
+// Solve cache file: "MZS1", format version, height and width as
+// little-endian uint32, then the SolveCacheKey, the result's flags and
+// termination, the SearchStats counters, the path (cells, or CompactPath runs),
+// explored_ as a bitset and every frame as one state byte per cell plus its
+// current path. All integers are little-endian.
+inline constexpr char kSolveCacheFileMagic[4] = {'M', 'Z', 'S', '1'};
+inline constexpr std::uint32_t kSolveCacheFileVersion = 1;
+
+MazeFileResult WriteSolveCacheFile(
+    const std::filesystem::path& path,
+    const MazeSolverDomain::SolveCacheKey& key,
+    const MazeSolverDomain::SearchResult& result, int height, int width);
+// nullopt with `error` set when the file is unreadable, damaged, or was
+// written for another key or grid size.
+std::optional<MazeSolverDomain::SearchResult> ReadSolveCacheFile(
+    const std::filesystem::path& path,
+    const MazeSolverDomain::SolveCacheKey& key, int height, int width,
+    std::string& error);
+
+// Read-only memory mapping of a packed maze file. Satisfies
+// MazeSolverDomain::WallGridAccess, so the memoryless solvers can walk it
+// while the OS pages cells in and out on demand.
+class MappedMazeFile {
+ public:
+  static std::optional<MappedMazeFile> Open(const std::filesystem::path& path,
+                                            std::string& error);
+
+  MappedMazeFile(const MappedMazeFile&) = delete;
+  auto operator=(const MappedMazeFile&) -> MappedMazeFile& = delete;
+  MappedMazeFile(MappedMazeFile&& other) noexcept;
+  auto operator=(MappedMazeFile&& other) noexcept -> MappedMazeFile&;
+  ~MappedMazeFile();
+
+  auto Height() const -> int { return height_; }
+  auto Width() const -> int { return width_; }
+  auto HasWall(int row, int col, int wall) const -> bool {
+    const std::uint64_t kCell =
+        (static_cast<std::uint64_t>(row) * static_cast<std::uint64_t>(width_)) +
+        static_cast<std::uint64_t>(col);
+    const std::uint8_t kByte = cells_[kCell / 2];
+    const unsigned kNibble = (kCell % 2 == 0) ? (kByte & 0xFU) : (kByte >> 4U);
+    return (kNibble & (1U << wall)) != 0;
+  }
+
+ private:
+  MappedMazeFile() = default;
+  void Release();
+
+  const std::uint8_t* base_ = nullptr;
+  const std::uint8_t* cells_ = nullptr;
+  size_t mapped_size_ = 0;
+  int height_ = 0;
+  int width_ = 0;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+}  // namespace MazeStorage
+
+#endif  // MAZE_FILE_H
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <chrono>  // Required for high-precision timing
+#include <cstdint>
 #include <filesystem>
 #include <iomanip>  // Required for std::fixed and std::setprecision
 #include <iostream>
@@ -8,7 +10,10 @@
 
 #include "application/services/maze_generation.h"
 #include "application/services/maze_solver.h"
+#include "cli/commands/distance_field_command.h"
+#include "cli/commands/fuzz_command.h"
 #include "cli/commands/generation_algorithms_command.h"
+#include "cli/commands/query_pairs_command.h"
 #include "cli/commands/search_algorithms_command.h"
 #include "cli/commands/version_command.h"
 #include "cli/framework/cli_app.h"
@@ -67,6 +72,45 @@ void PrintConfigSummary(const Config::AppConfig& config,
   PrintAlgorithmList(config.maze.generation_algorithms);
   std::cout << "Selected Search Algorithms: ";
   PrintSearchAlgorithmList(config.maze.search_algorithms);
+  if (!config.maze.query_pairs.empty()) {
+    std::cout << "Batch Query Pairs: " << config.maze.query_pairs.size()
+              << ", Batch Threads: " << config.maze.batch_threads << std::endl;
+  }
+  if (!config.maze.exit_nodes.empty()) {
+    std::cout << "Exit Nodes: " << config.maze.exit_nodes.size() << std::endl;
+  }
+  if (config.maze.distance_field) {
+    std::cout << "Distance Field Threads: "
+              << config.maze.distance_field_threads << std::endl;
+  }
+  if (config.maze.landmark_count > 0) {
+    std::cout << "A* Landmarks: " << config.maze.landmark_count << std::endl;
+  }
+  if (config.maze.search_threads > 0) {
+    std::cout << "Parallel A* Threads: " << config.maze.search_threads
+              << std::endl;
+  }
+  if (config.maze.dead_end_prefilter) {
+    std::cout << "Dead-End Prefilter: on" << std::endl;
+  }
+  if (config.maze.compact_paths) {
+    std::cout << "Compact Paths: on" << std::endl;
+  }
+  if (config.maze.flow_field_agents > 0) {
+    std::cout << "Flow Field Agents: " << config.maze.flow_field_agents
+              << std::endl;
+  }
+  if (config.maze.solve_cache_entries > 0) {
+    std::cout << "Solve Cache: " << config.maze.solve_cache_entries
+              << " entries";
+    if (config.maze.solve_cache_max_mib > 0) {
+      std::cout << ", up to " << config.maze.solve_cache_max_mib << " MiB";
+    }
+    if (!config.maze.solve_cache_dir.empty()) {
+      std::cout << ", persisted to " << config.maze.solve_cache_dir;
+    }
+    std::cout << std::endl;
+  }
 }
 
 void PrintLoadWarnings(const std::vector<std::string>& warnings) {
@@ -114,6 +158,33 @@ auto PrepareMazeGrid(const Config::MazeConfig& maze)
   return {kGridHeight, MazeGeneration::MazeGrid::value_type(kGridWidth)};
 }
 
+void PrintSearchStats(const MazeSolverDomain::SearchStats& stats) {
+  constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+  std::cout << "Search stats: expanded " << stats.expanded_ << ", pushed "
+            << stats.pushed_ << ", stale pops " << stats.stale_pops_
+            << ", peak frontier " << stats.peak_frontier_ << ", skipped "
+            << stats.skipped_ << ", filled " << stats.filled_ << ", frames "
+            << stats.frames_recorded_ << " (" << std::fixed
+            << std::setprecision(2)
+            << static_cast<double>(stats.frame_bytes_) / kBytesPerMiB
+            << " MiB), search time " << std::setprecision(3)
+            << stats.seconds_ << " s"
+            << (stats.from_cache_ ? " (served from the solve cache)" : "")
+            << std::endl;
+  if (stats.preprocess_seconds_ > 0.0) {
+    std::cout << "Preprocessing: " << std::setprecision(3)
+              << stats.preprocess_seconds_ << " s" << std::endl;
+  }
+  if (stats.landmarks_ > 0) {
+    const double kTableMiB =
+        static_cast<double>(stats.landmark_bytes_) / kBytesPerMiB;
+    std::cout << "Landmarks: " << stats.landmarks_ << ", table "
+              << std::setprecision(2) << kTableMiB << " MiB ("
+              << kTableMiB / static_cast<double>(stats.landmarks_)
+              << " MiB per landmark)" << std::endl;
+  }
+}
+
 void RunSolverAndRender(const MazeGeneration::MazeGrid& maze_grid,
                         const Config::AlgorithmInfo& algo_info,
                         const Config::AppConfig& config,
@@ -123,6 +194,17 @@ void RunSolverAndRender(const MazeGeneration::MazeGrid& maze_grid,
             << algo_info.name << ") ---" << std::endl;
   const auto kStartTime = Clock::now();
   const auto kResult = MazeSolver::Solve(maze_grid, solver_type, config);
+  PrintSearchStats(kResult.stats_);
+  if (config.maze.solve_cache_entries > 0) {
+    const auto kCache = MazeSolver::SolveCacheCounters();
+    std::cout << "Solve cache: " << kCache.hits_ + kCache.disk_hits_
+              << " hits (" << kCache.disk_hits_ << " from disk), "
+              << kCache.misses_ << " misses, " << kCache.evictions_
+              << " evictions, " << kCache.too_large_ << " too large, "
+              << std::fixed << std::setprecision(2)
+              << static_cast<double>(kCache.bytes_) / (1024.0 * 1024.0)
+              << " MiB held" << std::endl;
+  }
   const auto kRenderResult =
       MazeSolver::RenderSearchResult(kResult, maze_grid, solver_type,
                                      algo_info.name, config);
@@ -146,6 +228,300 @@ void RunSolverAndRender(const MazeGeneration::MazeGrid& maze_grid,
             << kResetColor << std::endl;
 }
 
+void RunBatchQueries(const MazeGeneration::MazeGrid& maze_grid,
+                     const Config::AlgorithmInfo& algo_info,
+                     const Config::AppConfig& config,
+                     const Config::SearchAlgorithmInfo& solver_info) {
+  std::cout << "--- " << solver_info.name << " Batch Queries ("
+            << algo_info.name << ") ---" << std::endl;
+  const auto kStartTime = Clock::now();
+  const auto kResults =
+      MazeSolver::SolveBatch(maze_grid, solver_info.type, config);
+  const auto kEndTime = Clock::now();
+  const auto kTimeTaken =
+      std::chrono::duration<double>(kEndTime - kStartTime);
+
+  size_t found_count = 0;
+  size_t stopped_count = 0;
+  size_t expanded_count = 0;
+  size_t path_cells = 0;
+  size_t path_bytes = 0;
+  for (const auto& result : kResults) {
+    expanded_count += result.expanded_;
+    path_cells += result.PathCells();
+    path_bytes += result.compact_path_.Empty()
+                      ? result.path_.size() * sizeof(result.path_[0])
+                      : result.compact_path_.Bytes();
+    if (result.found_) {
+      ++found_count;
+    }
+    if (result.termination_ != MazeSolver::SearchTermination::COMPLETED) {
+      ++stopped_count;
+    }
+  }
+  std::cout << "Answered " << kResults.size() << " queries, " << found_count
+            << " paths found, " << expanded_count << " cells expanded, "
+            << path_cells << " path cells in " << path_bytes << " bytes";
+  if (stopped_count > 0) {
+    std::cout << ", " << stopped_count << " stopped by search limits";
+  }
+  std::cout << "." << std::endl;
+  const double kQueriesPerSecond =
+      kTimeTaken.count() > 0.0
+          ? static_cast<double>(kResults.size()) / kTimeTaken.count()
+          : 0.0;
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for " << solver_info.name
+            << " batch queries: " << kTimeTaken.count() << " s ("
+            << std::setprecision(0) << kQueriesPerSecond << " queries/s)"
+            << kResetColor << std::endl;
+}
+
+void RunWeightedSearches(const MazeGeneration::MazeGrid& maze_grid,
+                         const Config::AlgorithmInfo& algo_info,
+                         const Config::AppConfig& config) {
+  std::cout << "--- Weighted Search (" << algo_info.name
+            << ", terrain costs 1-" << config.maze.terrain_cost_max << ") ---"
+            << std::endl;
+  const auto kWeights = MazeGeneration::generate_cell_weights(
+      config.maze.width, config.maze.height, config.maze.terrain_cost_max);
+  for (const auto kSolverType : {MazeSolver::SolverAlgorithmType::DIJKSTRA,
+                                 MazeSolver::SolverAlgorithmType::ASTAR}) {
+    const auto kStartTime = Clock::now();
+    MazeSolver::SolveWeighted(maze_grid, kWeights, kSolverType, config);
+    const auto kTimeTaken =
+        std::chrono::duration<double>(Clock::now() - kStartTime);
+    std::cout << kGreenColor << std::fixed << std::setprecision(3)
+              << "Time for weighted " << MazeSolver::AlgorithmName(kSolverType)
+              << ": " << kTimeTaken.count() << " s" << kResetColor
+              << std::endl;
+  }
+}
+
+void RunNearestExitSearches(const MazeGeneration::MazeGrid& maze_grid,
+                            const Config::AlgorithmInfo& algo_info,
+                            const Config::AppConfig& config) {
+  std::cout << "--- Nearest Exit (" << algo_info.name << ", "
+            << config.maze.exit_nodes.size() << " exits) ---" << std::endl;
+  for (const auto kSolverType : {MazeSolver::SolverAlgorithmType::BFS,
+                                 MazeSolver::SolverAlgorithmType::DIJKSTRA,
+                                 MazeSolver::SolverAlgorithmType::ASTAR}) {
+    const auto kStartTime = Clock::now();
+    MazeSolver::SolveNearestExit(maze_grid, kSolverType, config);
+    const auto kTimeTaken =
+        std::chrono::duration<double>(Clock::now() - kStartTime);
+    std::cout << kGreenColor << std::fixed << std::setprecision(3)
+              << "Time for nearest-exit "
+              << MazeSolver::AlgorithmName(kSolverType) << ": "
+              << kTimeTaken.count() << " s" << kResetColor << std::endl;
+  }
+}
+
+void RunIncrementalReplan(const MazeGeneration::MazeGrid& maze_grid,
+                          const Config::AlgorithmInfo& algo_info,
+                          const Config::AppConfig& config) {
+  std::cout << "--- Incremental Re-plan (" << algo_info.name << ") ---"
+            << std::endl;
+  const auto kStartTime = Clock::now();
+  const auto kReport = MazeSolver::ReplanAfterWallEdits(maze_grid, config);
+  const auto kTimeTaken =
+      std::chrono::duration<double>(Clock::now() - kStartTime);
+  std::cout << "Initial plan expanded " << kReport.initial.expanded_
+            << " cells; after " << kReport.toggles_applied
+            << " wall toggles the repair expanded "
+            << kReport.repair.expanded_ << " cells ("
+            << kReport.repair.updated_ << " rhs updates)." << std::endl;
+  if (kReport.found) {
+    std::cout << "Re-planned path length: " << kReport.path_length
+              << std::endl;
+  } else {
+    std::cout << "Re-plan: Path not found." << std::endl;
+  }
+  std::cout << "Hierarchical index rebuilt " << kReport.clusters_rebuilt
+            << " of " << kReport.cluster_count
+            << " clusters; path length after edits: "
+            << kReport.hierarchical_path_length << std::endl;
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for plan + re-plan: " << kTimeTaken.count() << " s"
+            << kResetColor << std::endl;
+}
+
+void PrintWalk(const char* label, const MazeSolver::WalkResult& walk) {
+  std::cout << label << ": " << (walk.found_ ? "reached the end" : "no path")
+            << " after " << walk.steps_ << " steps." << std::endl;
+}
+
+void RunMazeFileWalks(const MazeGeneration::MazeGrid& maze_grid,
+                      const Config::AlgorithmInfo& algo_info,
+                      const Config::AppConfig& config) {
+  std::cout << "--- Out-of-Core Walk (" << algo_info.name << ") ---"
+            << std::endl;
+  const auto kStartTime = Clock::now();
+  const auto kReport =
+      MazeSolver::WalkMazeFile(maze_grid, algo_info.name, config);
+  if (!kReport.ok) {
+    std::cerr << "Out-of-core walk: " << kReport.error << std::endl;
+    return;
+  }
+  std::cout << "Walking memory-mapped " << kReport.maze_file << std::endl;
+  PrintWalk("Wall Follower", kReport.wall_follower);
+  PrintWalk("Tremaux", kReport.tremaux);
+  if (kReport.tremaux.found_) {
+    std::cout << "Tremaux path length: " << kReport.tremaux_path_length
+              << std::endl;
+  }
+  const auto kTimeTaken =
+      std::chrono::duration<double>(Clock::now() - kStartTime);
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for maze file export + walks: " << kTimeTaken.count()
+            << " s" << kResetColor << std::endl;
+}
+
+void RunFlowFieldAgents(const MazeGeneration::MazeGrid& maze_grid,
+                        const Config::AlgorithmInfo& algo_info,
+                        const Config::AppConfig& config) {
+  std::cout << "--- Flow Field (" << algo_info.name << ") ---" << std::endl;
+  const auto kReport =
+      MazeSolver::RouteFlowFieldAgents(maze_grid, algo_info.name, config);
+  if (!kReport.ok) {
+    std::cerr << "Flow field: " << kReport.error << std::endl;
+    return;
+  }
+  std::cout << "Field to the end node reaches " << kReport.build.reached_cells_
+            << " cells, " << kReport.field_bytes << " bytes, saved to "
+            << kReport.flow_field_file << std::endl;
+  std::cout << kReport.agents_reached << " of " << kReport.agents
+            << " agents reached the end, " << kReport.total_steps
+            << " steps in total, longest " << kReport.longest_steps << "."
+            << std::endl;
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for flow field build: " << kReport.build.seconds_
+            << " s, agent routing: " << kReport.route_seconds << " s"
+            << kResetColor << std::endl;
+}
+
+void RunDistanceField(const MazeGeneration::MazeGrid& maze_grid,
+                      const Config::AlgorithmInfo& algo_info,
+                      const Config::AppConfig& config) {
+  std::cout << "--- Distance Field (" << algo_info.name << ") ---"
+            << std::endl;
+  const auto kField = MazeSolver::ComputeDistanceField(maze_grid, config);
+  if (kField.distances_.empty()) {
+    return;
+  }
+  std::uint32_t eccentricity = 0;
+  for (const std::uint32_t kDistance : kField.distances_) {
+    if (kDistance != MazeSolverDomain::kUnreachedDistance) {
+      eccentricity = std::max(eccentricity, kDistance);
+    }
+  }
+  const auto& stats = kField.stats_;
+  std::cout << "Reached " << stats.reached_cells_ << " of "
+            << kField.distances_.size() << " cells, farthest distance "
+            << eccentricity << ", " << stats.levels_ << " levels ("
+            << stats.bottom_up_levels_ << " bottom-up, "
+            << stats.parallel_levels_ << " parallel)." << std::endl;
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for distance field: " << stats.seconds_ << " s ("
+            << std::setprecision(0) << stats.EdgesPerSecond() << " edges/s)"
+            << kResetColor << std::endl;
+}
+
+void RunDistanceMatrix(const MazeGeneration::MazeGrid& maze_grid,
+                       const Config::AlgorithmInfo& algo_info,
+                       const Config::AppConfig& config) {
+  const auto kMatrix = MazeSolver::ComputeDistanceMatrix(maze_grid, config);
+  std::cout << "--- Distance Matrix (" << algo_info.name << ", "
+            << kMatrix.source_count_ << " points) ---" << std::endl;
+  size_t unreached = 0;
+  std::uint32_t farthest = 0;
+  for (const std::uint32_t kDistance : kMatrix.distances_) {
+    if (kDistance == MazeSolverDomain::kUnreachedDistance) {
+      ++unreached;
+    } else {
+      farthest = std::max(farthest, kDistance);
+    }
+  }
+  const auto& stats = kMatrix.stats_;
+  std::cout << kMatrix.distances_.size() << " pairs, " << unreached
+            << " unreachable, farthest pair " << farthest << "; "
+            << stats.passes_ << " passes, " << stats.levels_ << " levels, "
+            << stats.cell_expansions_ << " cell expansions." << std::endl;
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for distance matrix: " << stats.seconds_ << " s"
+            << kResetColor << std::endl;
+}
+
+// Copy of `config` with start/end moved to the ends of the maze's longest
+// shortest path.
+auto WithHardestEndpoints(const MazeGeneration::MazeGrid& maze_grid,
+                          const Config::AlgorithmInfo& algo_info,
+                          const Config::AppConfig& config)
+    -> Config::AppConfig {
+  std::cout << "--- Hardest Endpoints (" << algo_info.name << ") ---"
+            << std::endl;
+  const auto kStartTime = Clock::now();
+  const auto kEndpoints = MazeSolver::FindHardestEndpoints(maze_grid, config);
+  const auto kTimeTaken =
+      std::chrono::duration<double>(Clock::now() - kStartTime);
+  Config::AppConfig placed = config;
+  placed.maze.start_node = kEndpoints.start_;
+  placed.maze.end_node = kEndpoints.end_;
+  std::cout << "Start (" << kEndpoints.start_.first << ","
+            << kEndpoints.start_.second << "), End (" << kEndpoints.end_.first
+            << "," << kEndpoints.end_.second << "), distance "
+            << kEndpoints.distance_ << " ("
+            << (kEndpoints.exact_ ? "exact" : "approximate") << ", "
+            << kEndpoints.sweeps_ << " BFS sweeps)." << std::endl;
+  std::cout << kGreenColor << std::fixed << std::setprecision(3)
+            << "Time for endpoint placement: " << kTimeTaken.count() << " s"
+            << kResetColor << std::endl;
+  return placed;
+}
+
+void RunSolvers(const MazeGeneration::MazeGrid& maze_grid,
+                const Config::AlgorithmInfo& algo_info,
+                const Config::AppConfig& config) {
+  for (const auto& solver_info : config.maze.search_algorithms) {
+    RunSolverAndRender(maze_grid, algo_info, config, solver_info.type,
+                       solver_info.name.c_str());
+  }
+
+  if (!config.maze.query_pairs.empty()) {
+    for (const auto& solver_info : config.maze.search_algorithms) {
+      RunBatchQueries(maze_grid, algo_info, config, solver_info);
+    }
+  }
+
+  if (!config.maze.exit_nodes.empty()) {
+    RunNearestExitSearches(maze_grid, algo_info, config);
+  }
+
+  if (config.maze.distance_field) {
+    RunDistanceField(maze_grid, algo_info, config);
+  }
+
+  if (config.maze.distance_matrix) {
+    RunDistanceMatrix(maze_grid, algo_info, config);
+  }
+
+  if (config.maze.terrain_cost_max > 0) {
+    RunWeightedSearches(maze_grid, algo_info, config);
+  }
+
+  if (config.maze.replan_wall_edits > 0) {
+    RunIncrementalReplan(maze_grid, algo_info, config);
+  }
+
+  if (config.maze.out_of_core_walk) {
+    RunMazeFileWalks(maze_grid, algo_info, config);
+  }
+
+  if (config.maze.flow_field_agents > 0) {
+    RunFlowFieldAgents(maze_grid, algo_info, config);
+  }
+}
+
 void RunGenerationForAlgorithm(const Config::AppConfig& config,
                                const Config::AlgorithmInfo& algo_info) {
   std::cout << "\n--- Processing for Maze Generation Algorithm: "
@@ -173,9 +549,11 @@ void RunGenerationForAlgorithm(const Config::AppConfig& config,
 
   std::cout << "Maze generated." << std::endl;
 
-  for (const auto& solver_info : config.maze.search_algorithms) {
-    RunSolverAndRender(maze_grid, algo_info, config, solver_info.type,
-                       solver_info.name.c_str());
+  if (config.maze.hardest_endpoints) {
+    RunSolvers(maze_grid, algo_info,
+               WithHardestEndpoints(maze_grid, algo_info, config));
+  } else {
+    RunSolvers(maze_grid, algo_info, config);
   }
 }
 
@@ -248,6 +626,9 @@ auto main(int argc, char** argv) -> int {
   Cli::RegisterVersionCommand(cli);
   Cli::RegisterGenerationAlgorithmsCommand(cli);
   Cli::RegisterSearchAlgorithmsCommand(cli);
+  Cli::RegisterQueryPairsCommand(cli);
+  Cli::RegisterDistanceFieldCommand(cli);
+  Cli::RegisterFuzzCommand(cli);
   RegisterBuiltInCommands(cli);
 
   int cli_code = 0;